@@ -89,9 +89,14 @@ F_CONFIG_COLOR_SPRITE_KEY ?= 0xFF00FF
 #
 F_CONFIG_DEBUG ?= 0
 F_CONFIG_DEBUG_ALLOC ?= 0
+F_CONFIG_DEBUG_ALLOC_SITES ?= 0
 F_CONFIG_DEBUG_FATAL_SPIN ?= 0
 F_CONFIG_DEBUG_WAIT ?= 0
 
+ifneq ($(F_CONFIG_DEBUG_ALLOC_SITES), 0)
+    F_CONFIG_DEBUG_ALLOC := 1
+endif
+
 ifneq ($(F_CONFIG_DEBUG_ALLOC), 0)
     F_CONFIG_DEBUG := 1
 endif
@@ -195,6 +200,7 @@ F_CONFIG_LIB_SDL_CURSOR ?= 1
 F_CONFIG_LIB_SDL_GAMEPADMAP ?= gamecontrollerdb.txt
 F_CONFIG_LIB_SDL_MIXER_CHUNK_SIZE ?= 256
 F_CONFIG_LIB_SDL_MIXER_LIMITED_SUPPORT ?= 0
+F_CONFIG_LIB_SDL_THREADS ?= 0
 F_CONFIG_LIB_SDL_TIME ?= 1
 
 ifdef F_CONFIG_LIB_SDL_CONFIG
@@ -238,6 +244,7 @@ F_CONFIG_BUILD_FLAGS_SETTINGS := \
     -DF_CONFIG_CONSOLE_TOGGLE=$(F_CONFIG_CONSOLE_TOGGLE) \
     -DF_CONFIG_DEBUG=$(F_CONFIG_DEBUG) \
     -DF_CONFIG_DEBUG_ALLOC=$(F_CONFIG_DEBUG_ALLOC) \
+    -DF_CONFIG_DEBUG_ALLOC_SITES=$(F_CONFIG_DEBUG_ALLOC_SITES) \
     -DF_CONFIG_DEBUG_FATAL_SPIN=$(F_CONFIG_DEBUG_FATAL_SPIN) \
     -DF_CONFIG_DEBUG_WAIT=$(F_CONFIG_DEBUG_WAIT) \
     -DF_CONFIG_DIR_SCREENSHOTS=\"$(F_CONFIG_DIR_SCREENSHOTS)\" \
@@ -256,6 +263,7 @@ F_CONFIG_BUILD_FLAGS_SETTINGS := \
     -DF_CONFIG_LIB_SDL_GAMEPADMAP=\"$(F_CONFIG_LIB_SDL_GAMEPADMAP)\" \
     -DF_CONFIG_LIB_SDL_MIXER_CHUNK_SIZE=$(F_CONFIG_LIB_SDL_MIXER_CHUNK_SIZE) \
     -DF_CONFIG_LIB_SDL_MIXER_LIMITED_SUPPORT=$(F_CONFIG_LIB_SDL_MIXER_LIMITED_SUPPORT) \
+    -DF_CONFIG_LIB_SDL_THREADS=$(F_CONFIG_LIB_SDL_THREADS) \
     -DF_CONFIG_LIB_SDL_TIME=$(F_CONFIG_LIB_SDL_TIME) \
     -DF_CONFIG_SCREEN_RENDER_$(F_CONFIG_SCREEN_RENDER)=1 \
     -DF_CONFIG_SCREEN_FORMAT=$(F_CONFIG_SCREEN_FORMAT) \
@@ -17,3 +17,159 @@
 
 #include "f_collide.v.h"
 #include <faur.v.h>
+
+#if defined(__SSE2__)
+    #define F__SSE2 1
+    #include <emmintrin.h>
+#else
+    #define F__SSE2 0
+#endif
+
+// Batches fill one 32-bit hit word at a time, in chunks of 4 shapes when
+// SSE2 is there. The scalar loops have no branches, so compilers can
+// still vectorize them for other SIMD units.
+
+#if F__SSE2
+static inline unsigned boxAndBox4(__m128i X1, __m128i Y1, __m128i X1W, __m128i Y1H, const FFix* X, const FFix* Y, const FFix* W, const FFix* H)
+{
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(const void*)X);
+    __m128i y2 = _mm_loadu_si128((const __m128i*)(const void*)Y);
+    __m128i x2w = _mm_add_epi32(
+                    x2, _mm_loadu_si128((const __m128i*)(const void*)W));
+    __m128i y2h = _mm_add_epi32(
+                    y2, _mm_loadu_si128((const __m128i*)(const void*)H));
+
+    // x1 < x2 + w2 && x2 < x1 + w1 && y1 < y2 + h2 && y2 < y1 + h1
+    __m128i hit = _mm_and_si128(
+                    _mm_and_si128(_mm_cmplt_epi32(X1, x2w),
+                                  _mm_cmplt_epi32(x2, X1W)),
+                    _mm_and_si128(_mm_cmplt_epi32(Y1, y2h),
+                                  _mm_cmplt_epi32(y2, Y1H)));
+
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(hit));
+}
+#endif
+
+unsigned f_collide_boxAndBoxfBatch(FVecFix Coords, FVecFix Size, const FFix* X, const FFix* Y, const FFix* W, const FFix* H, unsigned Num, uint32_t* Hits)
+{
+    unsigned hitsNum = 0;
+
+    #if F__SSE2
+        __m128i x1 = _mm_set1_epi32(Coords.x);
+        __m128i y1 = _mm_set1_epi32(Coords.y);
+        __m128i x1w = _mm_set1_epi32(Coords.x + Size.x);
+        __m128i y1h = _mm_set1_epi32(Coords.y + Size.y);
+    #endif
+
+    for(unsigned b = 0; b < Num; b += 32) {
+        unsigned n = f_math_minu(32, Num - b);
+        unsigned i = 0;
+        uint32_t word = 0;
+
+        #if F__SSE2
+            for(; i + 4 <= n; i += 4) {
+                word |= (uint32_t)boxAndBox4(x1,
+                                             y1,
+                                             x1w,
+                                             y1h,
+                                             X + b + i,
+                                             Y + b + i,
+                                             W + b + i,
+                                             H + b + i) << i;
+            }
+        #endif
+
+        for(; i < n; i++) {
+            unsigned j = b + i;
+
+            word |= (uint32_t)((Coords.x < X[j] + W[j])
+                                & (X[j] < Coords.x + Size.x)
+                                & (Coords.y < Y[j] + H[j])
+                                & (Y[j] < Coords.y + Size.y)) << i;
+        }
+
+        Hits[b / 32] = word;
+        hitsNum += (unsigned)__builtin_popcount(word);
+    }
+
+    return hitsNum;
+}
+
+#if F__SSE2
+static inline __m128i abs4(__m128i X)
+{
+    __m128i sign = _mm_srai_epi32(X, 31);
+
+    return _mm_sub_epi32(_mm_xor_si128(X, sign), sign);
+}
+
+static inline unsigned circleAndCircle4(__m128i X1, __m128i Y1, __m128i R1, const FFix* X, const FFix* Y, const FFix* R)
+{
+    __m128i dx = abs4(_mm_sub_epi32(
+                        X1, _mm_loadu_si128((const __m128i*)(const void*)X)));
+    __m128i dy = abs4(_mm_sub_epi32(
+                        Y1, _mm_loadu_si128((const __m128i*)(const void*)Y)));
+    __m128i r = abs4(_mm_add_epi32(
+                        R1, _mm_loadu_si128((const __m128i*)(const void*)R)));
+
+    // Squares are 64-bit, _mm_mul_epu32 does lanes 0 and 2, so shift
+    // lanes 1 and 3 down for a second pass
+    __m128i distEven = _mm_add_epi64(_mm_mul_epu32(dx, dx),
+                                     _mm_mul_epu32(dy, dy));
+    __m128i rEven = _mm_mul_epu32(r, r);
+
+    dx = _mm_srli_epi64(dx, 32);
+    dy = _mm_srli_epi64(dy, 32);
+    r = _mm_srli_epi64(r, 32);
+
+    __m128i distOdd = _mm_add_epi64(_mm_mul_epu32(dx, dx),
+                                    _mm_mul_epu32(dy, dy));
+    __m128i rOdd = _mm_mul_epu32(r, r);
+
+    // Both sides are under 2^63, so dist < r^2 if the difference is negative
+    unsigned even = (unsigned)_mm_movemask_pd(
+                        _mm_castsi128_pd(_mm_sub_epi64(distEven, rEven)));
+    unsigned odd = (unsigned)_mm_movemask_pd(
+                        _mm_castsi128_pd(_mm_sub_epi64(distOdd, rOdd)));
+
+    return (even & 1) | (odd & 1) << 1 | (even & 2) << 1 | (odd & 2) << 2;
+}
+#endif
+
+unsigned f_collide_circleAndCirclefBatch(FVecFix Coords, FFix Radius, const FFix* X, const FFix* Y, const FFix* R, unsigned Num, uint32_t* Hits)
+{
+    unsigned hitsNum = 0;
+
+    #if F__SSE2
+        __m128i x1 = _mm_set1_epi32(Coords.x);
+        __m128i y1 = _mm_set1_epi32(Coords.y);
+        __m128i r1 = _mm_set1_epi32(Radius);
+    #endif
+
+    for(unsigned b = 0; b < Num; b += 32) {
+        unsigned n = f_math_minu(32, Num - b);
+        unsigned i = 0;
+        uint32_t word = 0;
+
+        #if F__SSE2
+            for(; i + 4 <= n; i += 4) {
+                word |= (uint32_t)circleAndCircle4(
+                            x1, y1, r1, X + b + i, Y + b + i, R + b + i) << i;
+            }
+        #endif
+
+        for(; i < n; i++) {
+            unsigned j = b + i;
+            int64_t dx = Coords.x - X[j];
+            int64_t dy = Coords.y - Y[j];
+            int64_t rSum = Radius + R[j];
+
+            word |= (uint32_t)(dx * dx + dy * dy < rSum * rSum) << i;
+        }
+
+        Hits[b / 32] = word;
+        hitsNum += (unsigned)__builtin_popcount(word);
+    }
+
+    return hitsNum;
+}
@@ -84,4 +84,7 @@ static inline bool f_collide_pointInCirclef(FVecFix Point, FVecFix CircleCoords,
     return dx * dx + dy * dy < (int64_t)CircleRadius * CircleRadius;
 }
 
+extern unsigned f_collide_boxAndBoxfBatch(FVecFix Coords, FVecFix Size, const FFix* X, const FFix* Y, const FFix* W, const FFix* H, unsigned Num, uint32_t* Hits);
+extern unsigned f_collide_circleAndCirclefBatch(FVecFix Coords, FFix Radius, const FFix* X, const FFix* Y, const FFix* R, unsigned Num, uint32_t* Hits);
+
 #endif // F_INC_COLLISION_COLLIDE_P_H
@@ -18,16 +18,47 @@
 #include "f_grid.v.h"
 #include <faur.v.h>
 
+typedef struct {
+    int shift; // right-shift FFix coords to get cell index
+    int w, h; // width and height of this level in cells
+    unsigned cellOffset; // index of this level's first cell in cellStart
+    unsigned itemsNum; // items placed on this level
+} FGridLevel;
+
+typedef struct {
+    uint64_t num, den; // where a raycast crosses a grid edge, 0 < num/den < 1
+} FGridSplit;
+
+struct FGridItem {
+    FGrid* grid; // grid this item is placed on
+    void* context; // reported by queries
+    unsigned index; // position in grid's items array
+    unsigned layers; // bitmask matched against query layers
+    unsigned queryStamp; // last query that reported this item
+    unsigned level; // grid level picked for the item's diameter
+    FFix diameter; // set with f_grid_itemDiameterSet
+    FVecFix coords; // set with f_grid_itemCoordsSet
+    FVecInt cellStart, cellEnd; // inclusive range of cells on its level
+};
+
 struct FGrid {
-    int shift; // right-shift item coords to get cell index
-    int w, h; // width and height of grid in cells
-    FList*** cells; // FList*[h][w] of void*
-    FList** cellsData; // FList*[h * w] of void*
+    FGridLevel* levels; // [levelsNum] cell size doubles on each level
+    unsigned levelsNum; // the last level is a single cell
+    FGridItem** items; // [itemsCapacity] every item on this grid
+    unsigned itemsNum; // used length of items array
+    unsigned itemsCapacity; // allocated length of items array
+    unsigned* cellStart; // [cellsNum + 1] each cell's span in cellContexts
+    unsigned cellsNum; // cells on all levels
+    void** cellContexts; // [cellContextsCapacity] item contexts by cell
+    FGridItem** cellItems; // [cellContextsCapacity] same order as contexts
+    unsigned cellContextsCapacity; // allocated length of cellContexts
+    unsigned queryStamp; // current query, to report each item once
+    bool dirty; // items moved since the cells were last built
 };
 
 FGrid* f_grid_new(FFix Width, FFix Height, FFix MaxItemDiameter)
 {
-    FGrid* g = f_mem_malloc(sizeof(FGrid));
+    FGrid* g = f_mem_mallocz(sizeof(FGrid));
 
     int shift = 0;
 
@@ -35,24 +66,37 @@ FGrid* f_grid_new(FFix Width, FFix Height, FFix MaxItemDiameter)
         shift++;
     }
 
-    g->shift = shift + 1;
+    // Level 0 cells are at least twice as wide as MaxItemDiameter,
+    // count the levels it takes to cover the grid with one cell
+    shift += 1 + F_FIX_BIT_PRECISION;
 
-    FFix cellDim = F_FIX_ONE << g->shift;
+    for(int s = shift; ; s++) {
+        g->levelsNum++;
 
-    g->w = f_fix_toInt((Width + cellDim - 1) >> g->shift);
-    g->h = f_fix_toInt((Height + cellDim - 1) >> g->shift);
+        if((((int64_t)Width - 1) >> s) <= 0
+            && (((int64_t)Height - 1) >> s) <= 0) {
 
-    g->cells = f_mem_malloc((unsigned)g->h * sizeof(FList**));
-    g->cellsData = f_mem_malloc((unsigned)(g->h * g->w) * sizeof(FList*));
+            break;
+        }
+    }
 
-    for(int i = g->h; i--; ) {
-        g->cells[i] = g->cellsData + i * g->w;
+    g->levels = f_mem_malloc(g->levelsNum * sizeof(FGridLevel));
 
-        for(int j = g->w; j--; ) {
-            g->cells[i][j] = f_list_new();
-        }
+    for(unsigned l = 0; l < g->levelsNum; l++) {
+        FGridLevel* level = &g->levels[l];
+        int64_t cellDim = (int64_t)1 << (shift + (int)l);
+
+        level->shift = shift + (int)l;
+        level->w = f_math_max(1, (int)((Width + cellDim - 1) >> level->shift));
+        level->h = f_math_max(1, (int)((Height + cellDim - 1) >> level->shift));
+        level->cellOffset = g->cellsNum;
+        level->itemsNum = 0;
+
+        g->cellsNum += (unsigned)(level->w * level->h);
     }
 
+    g->cellStart = f_mem_mallocz((g->cellsNum + 1) * sizeof(unsigned));
+
     return g;
 }
 
@@ -62,69 +106,633 @@ void f_grid_free(FGrid* Grid)
         return;
     }
 
-    for(int i = Grid->h; i--; ) {
-        for(int j = Grid->w; j--; ) {
-            f_list_free(Grid->cells[i][j]);
-        }
+    for(unsigned i = Grid->itemsNum; i--; ) {
+        f_mem_free(Grid->items[i]);
     }
 
-    f_mem_free(Grid->cells);
-    f_mem_free(Grid->cellsData);
+    f_mem_free(Grid->levels);
+    f_mem_free(Grid->items);
+    f_mem_free(Grid->cellStart);
+    f_mem_free(Grid->cellContexts);
+    f_mem_free(Grid->cellItems);
     f_mem_free(Grid);
 }
 
-const FList* f_grid_nearGet(const FGrid* Grid, FVecFix Coords)
+static inline unsigned cellIndexGet(const FGridLevel* Level, int X, int Y)
+{
+    return Level->cellOffset + (unsigned)(Y * Level->w + X);
+}
+
+static void cellsBuild(FGrid* Grid)
+{
+    unsigned* start = Grid->cellStart;
+    unsigned total = 0;
+
+    // Counting sort: count items per cell, ...
+    memset(start, 0, (Grid->cellsNum + 1) * sizeof(unsigned));
+
+    for(unsigned i = Grid->itemsNum; i--; ) {
+        const FGridItem* item = Grid->items[i];
+        const FGridLevel* level = &Grid->levels[item->level];
+
+        for(int y = item->cellStart.y; y <= item->cellEnd.y; y++) {
+            for(int x = item->cellStart.x; x <= item->cellEnd.x; x++) {
+                start[cellIndexGet(level, x, y) + 1]++;
+            }
+        }
+    }
+
+    // ... turn the counts into span offsets, ...
+    for(unsigned c = 1; c <= Grid->cellsNum; c++) {
+        start[c] += start[c - 1];
+    }
+
+    total = start[Grid->cellsNum];
+
+    if(total > Grid->cellContextsCapacity) {
+        unsigned capacity = f_math_maxu(Grid->cellContextsCapacity, 64);
+
+        while(capacity < total) {
+            capacity *= 2;
+        }
+
+        f_mem_free(Grid->cellContexts);
+        f_mem_free(Grid->cellItems);
+
+        Grid->cellContexts = f_mem_malloc(capacity * sizeof(void*));
+        Grid->cellItems = f_mem_malloc(capacity * sizeof(FGridItem*));
+        Grid->cellContextsCapacity = capacity;
+    }
+
+    // ... and place each item, using the span starts as write cursors
+    for(unsigned i = 0; i < Grid->itemsNum; i++) {
+        FGridItem* item = Grid->items[i];
+        const FGridLevel* level = &Grid->levels[item->level];
+
+        for(int y = item->cellStart.y; y <= item->cellEnd.y; y++) {
+            for(int x = item->cellStart.x; x <= item->cellEnd.x; x++) {
+                unsigned slot = start[cellIndexGet(level, x, y)]++;
+
+                Grid->cellContexts[slot] = item->context;
+                Grid->cellItems[slot] = item;
+            }
+        }
+    }
+
+    // The cursors ended on the next cell's start, shift them back by one
+    memmove(start + 1, start, Grid->cellsNum * sizeof(unsigned));
+    start[0] = 0;
+
+    Grid->dirty = false;
+}
+
+static inline int cellCoordGet(const FGridLevel* Level, FFix Coord, int Max)
+{
+    return f_math_clamp(Coord >> Level->shift, 0, Max);
+}
+
+unsigned f_grid_levelsGet(const FGrid* Grid)
+{
+    return Grid->levelsNum;
+}
+
+void* const* f_grid_nearGet(FGrid* Grid, unsigned Level, FVecFix Coords, unsigned* NumItems)
+{
+    #if F_CONFIG_DEBUG
+        if(Level >= Grid->levelsNum) {
+            F__FATAL("f_grid_nearGet(%u): Grid has %u levels",
+                     Level,
+                     Grid->levelsNum);
+        }
+    #endif
+
+    if(Grid->dirty) {
+        cellsBuild(Grid);
+    }
+
+    const FGridLevel* level = &Grid->levels[Level];
+    unsigned cell = cellIndexGet(level,
+                                 cellCoordGet(level, Coords.x, level->w - 1),
+                                 cellCoordGet(level, Coords.y, level->h - 1));
+
+    *NumItems = Grid->cellStart[cell + 1] - Grid->cellStart[cell];
+
+    return Grid->cellContexts + Grid->cellStart[cell];
+}
+
+static inline void pairAdd(const FGridItem* A, const FGridItem* B, unsigned LayersA, unsigned LayersB, FGridPair* Pairs, unsigned PairsMax, unsigned* Found)
+{
+    if((A->layers & LayersA) && (B->layers & LayersB)) {
+        if(*Found < PairsMax) {
+            Pairs[*Found].a = A->context;
+            Pairs[*Found].b = B->context;
+        }
+    } else if((B->layers & LayersA) && (A->layers & LayersB)) {
+        if(*Found < PairsMax) {
+            Pairs[*Found].a = B->context;
+            Pairs[*Found].b = A->context;
+        }
+    } else {
+        return;
+    }
+
+    (*Found)++;
+}
+
+unsigned f_grid_pairsFind(FGrid* Grid, unsigned LayersA, unsigned LayersB, FGridPair* Pairs, unsigned PairsMax)
+{
+    if(Grid->dirty) {
+        cellsBuild(Grid);
+    }
+
+    unsigned found = 0;
+
+    // Pairs of items on the same level
+    for(unsigned l = 0; l < Grid->levelsNum; l++) {
+        const FGridLevel* level = &Grid->levels[l];
+
+        if(level->itemsNum < 2) {
+            continue;
+        }
+
+        for(int y = 0; y < level->h; y++) {
+            for(int x = 0; x < level->w; x++) {
+                unsigned cell = cellIndexGet(level, x, y);
+                unsigned start = Grid->cellStart[cell];
+                unsigned end = Grid->cellStart[cell + 1];
+
+                for(unsigned i = start; i < end; i++) {
+                    const FGridItem* a = Grid->cellItems[i];
+
+                    for(unsigned j = i + 1; j < end; j++) {
+                        const FGridItem* b = Grid->cellItems[j];
+
+                        // Two items can share up to 4 cells, only report
+                        // the pair from the top-left one of those
+                        if(f_math_max(a->cellStart.x, b->cellStart.x) != x
+                            || f_math_max(a->cellStart.y, b->cellStart.y)
+                                != y) {
+
+                            continue;
+                        }
+
+                        pairAdd(
+                            a, b, LayersA, LayersB, Pairs, PairsMax, &found);
+                    }
+                }
+            }
+        }
+    }
+
+    // Pairs of an item and a bigger item from a higher level
+    for(unsigned i = Grid->itemsNum; i--; ) {
+        const FGridItem* a = Grid->items[i];
+
+        for(unsigned l = a->level + 1; l < Grid->levelsNum; l++) {
+            const FGridLevel* level = &Grid->levels[l];
+
+            if(level->itemsNum == 0) {
+                continue;
+            }
+
+            // The cells covering a's own cells, levels are aligned
+            int up = (int)(l - a->level);
+            int x1 = a->cellStart.x >> up;
+            int y1 = a->cellStart.y >> up;
+            int x2 = a->cellEnd.x >> up;
+            int y2 = a->cellEnd.y >> up;
+
+            for(int y = y1; y <= y2; y++) {
+                for(int x = x1; x <= x2; x++) {
+                    unsigned cell = cellIndexGet(level, x, y);
+
+                    for(unsigned j = Grid->cellStart[cell];
+                        j < Grid->cellStart[cell + 1];
+                        j++) {
+
+                        const FGridItem* b = Grid->cellItems[j];
+
+                        if(f_math_max(x1, b->cellStart.x) != x
+                            || f_math_max(y1, b->cellStart.y) != y) {
+
+                            continue;
+                        }
+
+                        pairAdd(
+                            a, b, LayersA, LayersB, Pairs, PairsMax, &found);
+                    }
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+static void queryStart(FGrid* Grid)
+{
+    if(Grid->dirty) {
+        cellsBuild(Grid);
+    }
+
+    if(++Grid->queryStamp == 0) {
+        // Wrapped around, forget old stamps so none of them match
+        for(unsigned i = Grid->itemsNum; i--; ) {
+            Grid->items[i]->queryStamp = 0;
+        }
+
+        Grid->queryStamp = 1;
+    }
+}
+
+static void queryCell(FGrid* Grid, const FGridLevel* Level, int X, int Y, unsigned Layers, void** Items, unsigned ItemsMax, unsigned* Found)
+{
+    unsigned cell = cellIndexGet(Level, X, Y);
+
+    for(unsigned i = Grid->cellStart[cell];
+        i < Grid->cellStart[cell + 1];
+        i++) {
+
+        FGridItem* item = Grid->cellItems[i];
+
+        if(item->queryStamp == Grid->queryStamp
+            || !(item->layers & Layers)) {
+
+            continue;
+        }
+
+        item->queryStamp = Grid->queryStamp;
+
+        if(*Found < ItemsMax) {
+            Items[*Found] = item->context;
+        }
+
+        (*Found)++;
+    }
+}
+
+unsigned f_grid_queryBox(FGrid* Grid, FVecFix Coords, FVecFix Size, unsigned Layers, void** Items, unsigned ItemsMax)
+{
+    queryStart(Grid);
+
+    unsigned found = 0;
+
+    for(unsigned l = 0; l < Grid->levelsNum; l++) {
+        const FGridLevel* level = &Grid->levels[l];
+
+        if(level->itemsNum == 0) {
+            continue;
+        }
+
+        int x1 = cellCoordGet(level, Coords.x, level->w - 1);
+        int y1 = cellCoordGet(level, Coords.y, level->h - 1);
+        int x2 = cellCoordGet(level, Coords.x + Size.x - 1, level->w - 1);
+        int y2 = cellCoordGet(level, Coords.y + Size.y - 1, level->h - 1);
+
+        for(int y = y1; y <= y2; y++) {
+            for(int x = x1; x <= x2; x++) {
+                queryCell(Grid, level, x, y, Layers, Items, ItemsMax, &found);
+            }
+        }
+    }
+
+    return found;
+}
+
+unsigned f_grid_queryCircle(FGrid* Grid, FVecFix Coords, FFix Radius, unsigned Layers, void** Items, unsigned ItemsMax)
+{
+    queryStart(Grid);
+
+    unsigned found = 0;
+    int64_t r2 = (int64_t)Radius * Radius;
+
+    for(unsigned l = 0; l < Grid->levelsNum; l++) {
+        const FGridLevel* level = &Grid->levels[l];
+
+        if(level->itemsNum == 0) {
+            continue;
+        }
+
+        int64_t cellDim = (int64_t)1 << level->shift;
+        int x1 = cellCoordGet(level, Coords.x - Radius, level->w - 1);
+        int y1 = cellCoordGet(level, Coords.y - Radius, level->h - 1);
+        int x2 = cellCoordGet(level, Coords.x + Radius, level->w - 1);
+        int y2 = cellCoordGet(level, Coords.y + Radius, level->h - 1);
+
+        for(int y = y1; y <= y2; y++) {
+            // Distance from the center to the nearest point in this cell
+            // row, border cells also hold everything past the grid's edges
+            int64_t dy = 0;
+
+            if(y > 0 && Coords.y < y * cellDim) {
+                dy = y * cellDim - Coords.y;
+            } else if(y < level->h - 1 && Coords.y >= (y + 1) * cellDim) {
+                dy = Coords.y - (y + 1) * cellDim + 1;
+            }
+
+            for(int x = x1; x <= x2; x++) {
+                int64_t dx = 0;
+
+                if(x > 0 && Coords.x < x * cellDim) {
+                    dx = x * cellDim - Coords.x;
+                } else if(x < level->w - 1
+                    && Coords.x >= (x + 1) * cellDim) {
+
+                    dx = Coords.x - (x + 1) * cellDim + 1;
+                }
+
+                if(dx * dx + dy * dy <= r2) {
+                    queryCell(
+                        Grid, level, x, y, Layers, Items, ItemsMax, &found);
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+static inline int64_t coordClamp(int64_t Coord, int64_t Max)
+{
+    return Coord < 0 ? 0 : (Coord > Max ? Max : Coord);
+}
+
+static void raycastPiece(FGrid* Grid, const FGridLevel* Level, int64_t StartX, int64_t StartY, int64_t EndX, int64_t EndY, bool SkipFirst, unsigned Layers, void** Items, unsigned ItemsMax, unsigned* Found)
+{
+    int64_t cellDim = (int64_t)1 << Level->shift;
+    int x = (int)(StartX >> Level->shift);
+    int y = (int)(StartY >> Level->shift);
+    int xEnd = (int)(EndX >> Level->shift);
+    int yEnd = (int)(EndY >> Level->shift);
+    int stepX = EndX > StartX ? 1 : -1;
+    int stepY = EndY > StartY ? 1 : -1;
+    int64_t dx = EndX > StartX ? EndX - StartX : StartX - EndX;
+    int64_t dy = EndY > StartY ? EndY - StartY : StartY - EndY;
+
+    // DDA, visit cells in the order the segment enters them
+    while(true) {
+        if(!SkipFirst) {
+            queryCell(Grid, Level, x, y, Layers, Items, ItemsMax, Found);
+        }
+
+        SkipFirst = false;
+
+        if(x == xEnd && y == yEnd) {
+            break;
+        }
+
+        // Distance from start to the next vertical and horizontal edges
+        int64_t edgeX = stepX > 0
+                            ? (x + 1) * cellDim - StartX
+                            : StartX - x * cellDim + 1;
+        int64_t edgeY = stepY > 0
+                            ? (y + 1) * cellDim - StartY
+                            : StartY - y * cellDim + 1;
+
+        // Compare edgeX / dx with edgeY / dy, whichever edge comes first
+        if(y == yEnd || (x != xEnd && edgeX * dy <= edgeY * dx)) {
+            x += stepX;
+        } else {
+            y += stepY;
+        }
+    }
+}
+
+static unsigned splitAdd(FGridSplit* Splits, unsigned SplitsNum, int64_t Start, int64_t Delta, int64_t Edge)
 {
-    int x = f_math_clamp(f_fix_toInt(Coords.x >> Grid->shift), 0, Grid->w - 1);
-    int y = f_math_clamp(f_fix_toInt(Coords.y >> Grid->shift), 0, Grid->h - 1);
+    int64_t num = Edge - Start;
+    int64_t den = Delta;
+
+    if(den < 0) {
+        num = -num;
+        den = -den;
+    }
+
+    if(num <= 0 || num >= den) {
+        return SplitsNum;
+    }
 
-    return Grid->cells[y][x];
+    FGridSplit split = {(uint64_t)num, (uint64_t)den};
+
+    // Keep sorted, there are at most 4 edge crossings. Both sides are under
+    // 2^64 since num < den and segment deltas are under 2^32.
+    unsigned i = SplitsNum;
+
+    for(; i > 0
+            && Splits[i - 1].num * split.den > split.num * Splits[i - 1].den;
+          i--) {
+
+        Splits[i] = Splits[i - 1];
+    }
+
+    Splits[i] = split;
+
+    return SplitsNum + 1;
 }
 
-FGridItem* f_grid_itemNew(void)
+static inline int64_t splitCoordGet(int64_t Start, int64_t Delta, FGridSplit Split)
 {
-    return f_list_new();
+    uint64_t offset = (uint64_t)(Delta < 0 ? -Delta : Delta) * Split.num
+                        / Split.den;
+
+    return Delta < 0 ? Start - (int64_t)offset : Start + (int64_t)offset;
+}
+
+static void raycastLevel(FGrid* Grid, const FGridLevel* Level, FVecFix Start, FVecFix End, unsigned Layers, void** Items, unsigned ItemsMax, unsigned* Found)
+{
+    int64_t cellDim = (int64_t)1 << Level->shift;
+    int64_t maxX = Level->w * cellDim - 1;
+    int64_t maxY = Level->h * cellDim - 1;
+    int64_t dx = (int64_t)End.x - Start.x;
+    int64_t dy = (int64_t)End.y - Start.y;
+
+    // Split the segment where it crosses the grid's edge lines, so on each
+    // piece every axis is either fully inside or fully past an edge. Points
+    // past the edges belong to the border cells, and clamping a piece's
+    // endpoints keeps it straight: inside pieces walk the inner cells, the
+    // rest walk along the border row or column they project onto.
+    FGridSplit splits[5];
+    unsigned splitsNum = 0;
+
+    splitsNum = splitAdd(splits, splitsNum, Start.x, dx, 0);
+    splitsNum = splitAdd(splits, splitsNum, Start.x, dx, maxX);
+    splitsNum = splitAdd(splits, splitsNum, Start.y, dy, 0);
+    splitsNum = splitAdd(splits, splitsNum, Start.y, dy, maxY);
+
+    int64_t x1 = coordClamp(Start.x, maxX);
+    int64_t y1 = coordClamp(Start.y, maxY);
+
+    for(unsigned s = 0; s <= splitsNum; s++) {
+        int64_t x2, y2;
+
+        if(s == splitsNum) {
+            x2 = coordClamp(End.x, maxX);
+            y2 = coordClamp(End.y, maxY);
+        } else {
+            x2 = coordClamp(splitCoordGet(Start.x, dx, splits[s]), maxX);
+            y2 = coordClamp(splitCoordGet(Start.y, dy, splits[s]), maxY);
+        }
+
+        // Pieces after the first start in the cell the previous one ended in
+        raycastPiece(Grid,
+                     Level,
+                     x1,
+                     y1,
+                     x2,
+                     y2,
+                     s > 0,
+                     Layers,
+                     Items,
+                     ItemsMax,
+                     Found);
+
+        x1 = x2;
+        y1 = y2;
+    }
+}
+
+unsigned f_grid_raycast(FGrid* Grid, FVecFix Start, FVecFix End, unsigned Layers, void** Items, unsigned ItemsMax)
+{
+    queryStart(Grid);
+
+    unsigned found = 0;
+
+    for(unsigned l = 0; l < Grid->levelsNum; l++) {
+        const FGridLevel* level = &Grid->levels[l];
+
+        if(level->itemsNum > 0) {
+            raycastLevel(
+                Grid, level, Start, End, Layers, Items, ItemsMax, &found);
+        }
+    }
+
+    return found;
+}
+
+FGridItem* f_grid_itemNew(FGrid* Grid, void* Context)
+{
+    FGridItem* item = f_mem_malloc(sizeof(FGridItem));
+
+    if(Grid->itemsNum == Grid->itemsCapacity) {
+        unsigned capacity = f_math_maxu(Grid->itemsCapacity * 2, 16);
+        FGridItem** items = f_mem_malloc(capacity * sizeof(FGridItem*));
+
+        if(Grid->items) {
+            memcpy(items, Grid->items, Grid->itemsNum * sizeof(FGridItem*));
+            f_mem_free(Grid->items);
+        }
+
+        Grid->items = items;
+        Grid->itemsCapacity = capacity;
+    }
+
+    item->grid = Grid;
+    item->context = Context;
+    item->index = Grid->itemsNum;
+    item->layers = 1;
+    item->queryStamp = 0;
+    item->level = 0;
+    item->diameter = 0;
+    item->coords.x = 0;
+    item->coords.y = 0;
+
+    // Not in any cell until it gets coords
+    item->cellStart.x = 0;
+    item->cellStart.y = 0;
+    item->cellEnd.x = -1;
+    item->cellEnd.y = -1;
+
+    Grid->items[Grid->itemsNum++] = item;
+    Grid->levels[0].itemsNum++;
+
+    return item;
 }
 
 void f_grid_itemFree(FGridItem* Item)
 {
-    // Remove item from any lists it is in
-    f_list_freeEx(Item, (FCallFree*)f_list_removeNode);
+    if(Item == NULL) {
+        return;
+    }
+
+    FGrid* g = Item->grid;
+    FGridItem* last = g->items[--g->itemsNum];
+
+    last->index = Item->index;
+    g->items[Item->index] = last;
+    g->levels[Item->level].itemsNum--;
+    g->dirty = true;
+
+    f_mem_free(Item);
 }
 
-void f_grid_itemCoordsSet(const FGrid* Grid, FGridItem* Item, void* Context, FVecFix Coords)
+static void itemPlace(FGridItem* Item)
 {
-    // remove item from all the cells it was previously in
-    f_list_clearEx(Item, (FCallFree*)f_list_removeNode);
+    const FGridLevel* level = &Item->grid->levels[Item->level];
+    FVecFix coords = Item->coords;
 
     // center cell coords
-    int cellX = f_fix_toInt(Coords.x >> Grid->shift);
-    int cellY = f_fix_toInt(Coords.y >> Grid->shift);
+    int cellX = coords.x >> level->shift;
+    int cellY = coords.y >> level->shift;
 
-    FVecInt cellStart, cellEnd;
-    FFix cellDim = F_FIX_ONE << Grid->shift;
-    FVecFix cellOffset = {Coords.x & (cellDim - 1), Coords.y & (cellDim - 1)};
+    int64_t cellDim = (int64_t)1 << level->shift;
+    int64_t offsetX = coords.x & (cellDim - 1);
+    int64_t offsetY = coords.y & (cellDim - 1);
 
-    if(cellOffset.x < cellDim / 2) {
-        cellStart.x = f_math_clamp(cellX - 1, 0, Grid->w - 1);
-        cellEnd.x = f_math_clamp(cellX, 0, Grid->w - 1);
+    // the item is in every cell in its surrounding perimeter
+    if(offsetX < cellDim / 2) {
+        Item->cellStart.x = f_math_clamp(cellX - 1, 0, level->w - 1);
+        Item->cellEnd.x = f_math_clamp(cellX, 0, level->w - 1);
     } else {
-        cellStart.x = f_math_clamp(cellX, 0, Grid->w - 1);
-        cellEnd.x = f_math_clamp(cellX + 1, 0, Grid->w - 1);
+        Item->cellStart.x = f_math_clamp(cellX, 0, level->w - 1);
+        Item->cellEnd.x = f_math_clamp(cellX + 1, 0, level->w - 1);
     }
 
-    if(cellOffset.y < cellDim / 2) {
-        cellStart.y = f_math_clamp(cellY - 1, 0, Grid->h - 1);
-        cellEnd.y = f_math_clamp(cellY, 0, Grid->h - 1);
+    if(offsetY < cellDim / 2) {
+        Item->cellStart.y = f_math_clamp(cellY - 1, 0, level->h - 1);
+        Item->cellEnd.y = f_math_clamp(cellY, 0, level->h - 1);
     } else {
-        cellStart.y = f_math_clamp(cellY, 0, Grid->h - 1);
-        cellEnd.y = f_math_clamp(cellY + 1, 0, Grid->h - 1);
+        Item->cellStart.y = f_math_clamp(cellY, 0, level->h - 1);
+        Item->cellEnd.y = f_math_clamp(cellY + 1, 0, level->h - 1);
     }
 
-    // add item to every cell in its surrounding perimeter
-    for(int y = cellStart.y; y <= cellEnd.y; y++) {
-        for(int x = cellStart.x; x <= cellEnd.x; x++) {
-            f_list_addFirst(Item, f_list_addFirst(Grid->cells[y][x], Context));
+    Item->grid->dirty = true;
+}
+
+void f_grid_itemCoordsSet(FGridItem* Item, FVecFix Coords)
+{
+    Item->coords = Coords;
+
+    itemPlace(Item);
+}
+
+void f_grid_itemDiameterSet(FGridItem* Item, FFix Diameter)
+{
+    FGrid* g = Item->grid;
+    unsigned level = 0;
+
+    // Items need cells at least twice their diameter, the top level's
+    // single cell holds whatever is still too big
+    while(level < g->levelsNum - 1
+        && ((int64_t)1 << (g->levels[level].shift - 1)) < Diameter) {
+
+        level++;
+    }
+
+    Item->diameter = Diameter;
+
+    if(level != Item->level) {
+        g->levels[Item->level].itemsNum--;
+        g->levels[level].itemsNum++;
+
+        Item->level = level;
+
+        if(Item->cellEnd.x >= 0) {
+            itemPlace(Item);
         }
     }
 }
+
+void f_grid_itemLayersSet(FGridItem* Item, unsigned Layers)
+{
+    Item->layers = Layers;
+}
@@ -21,19 +21,32 @@
 #include "../general/f_system_includes.h"
 
 typedef struct FGrid FGrid;
-typedef struct FList FGridItem;
+typedef struct FGridItem FGridItem;
+
+typedef struct {
+    void* a; // context of the item on one of the LayersA layers
+    void* b; // context of the item on one of the LayersB layers
+} FGridPair;
 
-#include "../data/f_list.p.h"
 #include "../math/f_vec.p.h"
 
 extern FGrid* f_grid_new(FFix Width, FFix Height, FFix MaxItemDiameter);
 extern void f_grid_free(FGrid* Grid);
 
-extern const FList* f_grid_nearGet(const FGrid* Grid, FVecFix Coords);
+extern unsigned f_grid_levelsGet(const FGrid* Grid);
+
+extern void* const* f_grid_nearGet(FGrid* Grid, unsigned Level, FVecFix Coords, unsigned* NumItems);
+extern unsigned f_grid_pairsFind(FGrid* Grid, unsigned LayersA, unsigned LayersB, FGridPair* Pairs, unsigned PairsMax);
+
+extern unsigned f_grid_queryBox(FGrid* Grid, FVecFix Coords, FVecFix Size, unsigned Layers, void** Items, unsigned ItemsMax);
+extern unsigned f_grid_queryCircle(FGrid* Grid, FVecFix Coords, FFix Radius, unsigned Layers, void** Items, unsigned ItemsMax);
+extern unsigned f_grid_raycast(FGrid* Grid, FVecFix Start, FVecFix End, unsigned Layers, void** Items, unsigned ItemsMax);
 
-extern FGridItem* f_grid_itemNew(void);
+extern FGridItem* f_grid_itemNew(FGrid* Grid, void* Context);
 extern void f_grid_itemFree(FGridItem* Item);
 
-extern void f_grid_itemCoordsSet(const FGrid* Grid, FGridItem* Item, void* Context, FVecFix Coords);
+extern void f_grid_itemCoordsSet(FGridItem* Item, FVecFix Coords);
+extern void f_grid_itemDiameterSet(FGridItem* Item, FFix Diameter);
+extern void f_grid_itemLayersSet(FGridItem* Item, unsigned Layers);
 
 #endif // F_INC_COLLISION_GRID_P_H
@@ -0,0 +1,273 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "f_array.v.h"
+#include <faur.v.h>
+
+#define F__CAPACITY_START 8
+
+const FArray f__array_empty;
+
+FArray* f_array_new(void)
+{
+    return f_pool__alloc(F_POOL__ARRAY);
+}
+
+FArray* f_array_newFromList(const FList* List)
+{
+    FArray* a = f_array_new();
+    unsigned num = f_list_sizeGet(List);
+
+    if(num > 0) {
+        a->items = f_mem_malloc(num * sizeof(void*));
+        a->num = num;
+        a->capacity = num;
+
+        F_LIST_ITERATE(List, void*, item) {
+            a->items[F_LIST_INDEX()] = item;
+        }
+    }
+
+    return a;
+}
+
+void f_array_free(FArray* Array)
+{
+    f_array_freeEx(Array, NULL);
+}
+
+void f_array_freeEx(FArray* Array, FCallFree* Free)
+{
+    if(Array == NULL) {
+        return;
+    }
+
+    f_array_clearEx(Array, Free);
+
+    f_mem_free(Array->items);
+    f_pool_release(Array);
+}
+
+static void itemsGrow(FArray* Array, unsigned Capacity)
+{
+    void** items = f_mem_malloc(Capacity * sizeof(void*));
+
+    if(Array->items) {
+        memcpy(items, Array->items, Array->num * sizeof(void*));
+        f_mem_free(Array->items);
+    }
+
+    Array->items = items;
+    Array->capacity = Capacity;
+}
+
+void f_array_add(FArray* Array, void* Content)
+{
+    if(Array->num == Array->capacity) {
+        itemsGrow(Array,
+                  f_math_maxu(F__CAPACITY_START, Array->capacity * 2));
+    }
+
+    Array->items[Array->num++] = Content;
+}
+
+void* f_array_get(const FArray* Array, unsigned Index)
+{
+    #if F_CONFIG_DEBUG
+        if(Index >= Array->num) {
+            F__FATAL("f_array_get(%u): Array has %u items", Index, Array->num);
+        }
+    #endif
+
+    return Array->items[Index];
+}
+
+void* f_array_getLast(const FArray* Array)
+{
+    return Array->num > 0 ? Array->items[Array->num - 1] : NULL;
+}
+
+void* f_array_removeItem(FArray* Array, const void* Item)
+{
+    for(unsigned i = 0; i < Array->num; i++) {
+        if(Array->items[i] == Item) {
+            return f_array_removeIndex(Array, i);
+        }
+    }
+
+    return NULL;
+}
+
+void* f_array_removeIndex(FArray* Array, unsigned Index)
+{
+    void* item = f_array_get(Array, Index);
+
+    memmove(&Array->items[Index],
+            &Array->items[Index + 1],
+            (--Array->num - Index) * sizeof(void*));
+
+    return item;
+}
+
+void* f_array_removeIndexSwap(FArray* Array, unsigned Index)
+{
+    void* item = f_array_get(Array, Index);
+
+    Array->items[Index] = Array->items[--Array->num];
+
+    return item;
+}
+
+void* f_array_removeLast(FArray* Array)
+{
+    return Array->num > 0 ? Array->items[--Array->num] : NULL;
+}
+
+void f_array_clear(FArray* Array)
+{
+    Array->num = 0;
+}
+
+void f_array_clearEx(FArray* Array, FCallFree* Free)
+{
+    if(Free) {
+        for(unsigned i = 0; i < Array->num; i++) {
+            Free(Array->items[i]);
+        }
+    }
+
+    Array->num = 0;
+}
+
+// Stable bottom-up merge sort, returns Items or Scratch with the result
+void** f_array__sortMerge(void** Items, void** Scratch, unsigned Num, FCallArraySortCompare* Compare, void* Context)
+{
+    void** src = Items;
+    void** dst = Scratch;
+
+    for(unsigned width = 1; width < Num; width *= 2) {
+        for(unsigned start = 0; start < Num; start += 2 * width) {
+            unsigned mid = f_math_minu(start + width, Num);
+            unsigned end = f_math_minu(start + 2 * width, Num);
+            unsigned a = start;
+            unsigned b = mid;
+
+            // Take from the left run on ties
+            for(unsigned i = start; i < end; i++) {
+                if(a < mid
+                    && (b == end || Compare(Context, src[a], src[b]) <= 0)) {
+
+                    dst[i] = src[a++];
+                } else {
+                    dst[i] = src[b++];
+                }
+            }
+        }
+
+        void** save = src;
+
+        src = dst;
+        dst = save;
+    }
+
+    return src;
+}
+
+static int sortCompare(void* Context, const void* A, const void* B)
+{
+    return (*(FCallListCompare**)Context)(A, B);
+}
+
+void f_array_sort(FArray* Array, FCallListCompare* Compare)
+{
+    unsigned num = Array->num;
+
+    if(num < 2) {
+        return;
+    }
+
+    // The spare capacity past num is the merge scratch
+    if(Array->capacity < 2 * num) {
+        itemsGrow(Array, 2 * num);
+    }
+
+    void** sorted = f_array__sortMerge(Array->items,
+                                       Array->items + num,
+                                       num,
+                                       sortCompare,
+                                       &Compare);
+
+    if(sorted != Array->items) {
+        memcpy(Array->items, sorted, num * sizeof(void*));
+    }
+}
+
+unsigned f_array_sizeGet(const FArray* Array)
+{
+    return Array->num;
+}
+
+bool f_array_sizeIsEmpty(const FArray* Array)
+{
+    return Array->num == 0;
+}
+
+bool f_array_contains(const FArray* Array, const void* Item)
+{
+    for(unsigned i = Array->num; i--; ) {
+        if(Array->items[i] == Item) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+F__ArrayIt f__arrayit_new(const FArray* Array)
+{
+    F__ArrayIt it;
+
+    it.array = (FArray*)Array;
+    it.index = UINT_MAX;
+
+    return it;
+}
+
+bool f__arrayit_getNext(F__ArrayIt* Iterator, void* UserPtrAddress)
+{
+    unsigned next = Iterator->index + 1;
+
+    if(next >= Iterator->array->num) {
+        return false;
+    }
+
+    *(void**)UserPtrAddress = Iterator->array->items[next];
+    Iterator->index = next;
+
+    return true;
+}
+
+void f__arrayit_remove(F__ArrayIt* Iterator)
+{
+    // Step back so the next call returns the item that moved in here
+    f_array_removeIndex(Iterator->array, Iterator->index--);
+}
+
+bool f__arrayit_isLast(const F__ArrayIt* Iterator)
+{
+    return Iterator->index + 1 == Iterator->array->num;
+}
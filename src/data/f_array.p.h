@@ -0,0 +1,74 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef F_INC_DATA_ARRAY_P_H
+#define F_INC_DATA_ARRAY_P_H
+
+#include "../general/f_system_includes.h"
+
+typedef struct FArray FArray;
+
+#include "../data/f_list.p.h"
+
+extern FArray* f_array_new(void);
+extern FArray* f_array_newFromList(const FList* List);
+extern void f_array_free(FArray* Array);
+extern void f_array_freeEx(FArray* Array, FCallFree* Free);
+
+extern void f_array_add(FArray* Array, void* Content);
+
+extern void* f_array_get(const FArray* Array, unsigned Index);
+extern void* f_array_getLast(const FArray* Array);
+
+extern void* f_array_removeItem(FArray* Array, const void* Item);
+extern void* f_array_removeIndex(FArray* Array, unsigned Index);
+extern void* f_array_removeIndexSwap(FArray* Array, unsigned Index);
+extern void* f_array_removeLast(FArray* Array);
+
+extern void f_array_clear(FArray* Array);
+extern void f_array_clearEx(FArray* Array, FCallFree* Free);
+
+extern void f_array_sort(FArray* Array, FCallListCompare* Compare);
+
+extern unsigned f_array_sizeGet(const FArray* Array);
+extern bool f_array_sizeIsEmpty(const FArray* Array);
+
+extern bool f_array_contains(const FArray* Array, const void* Item);
+
+typedef struct {
+    FArray* array;
+    unsigned index;
+} F__ArrayIt;
+
+extern F__ArrayIt f__arrayit_new(const FArray* Array);
+
+extern bool f__arrayit_getNext(F__ArrayIt* Iterator, void* UserPtrAddress);
+extern void f__arrayit_remove(F__ArrayIt* Iterator);
+extern bool f__arrayit_isLast(const F__ArrayIt* Iterator);
+
+#define F_ARRAY_ITERATE(Array, PtrType, Name)                         \
+    for(F__ArrayIt f__it = f__arrayit_new(Array);                     \
+        f__it.array != NULL;                                          \
+        f__it.array = NULL)                                           \
+        for(PtrType Name; f__arrayit_getNext(&f__it, (void*)&Name); )
+
+#define F_ARRAY_INDEX() f__it.index
+#define F_ARRAY_REMOVE() f__arrayit_remove(&f__it)
+#define F_ARRAY_IS_FIRST() (f__it.index == 0)
+#define F_ARRAY_IS_LAST() f__arrayit_isLast(&f__it)
+
+#endif // F_INC_DATA_ARRAY_P_H
@@ -0,0 +1,35 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef F_INC_DATA_ARRAY_V_H
+#define F_INC_DATA_ARRAY_V_H
+
+#include "f_array.p.h"
+
+struct FArray {
+    void** items; // [capacity]
+    unsigned num; // used length of items
+    unsigned capacity; // allocated length of items
+};
+
+extern const FArray f__array_empty;
+
+typedef int FCallArraySortCompare(void* Context, const void* A, const void* B);
+
+extern void** f_array__sortMerge(void** Items, void** Scratch, unsigned Num, FCallArraySortCompare* Compare, void* Context);
+
+#endif // F_INC_DATA_ARRAY_V_H
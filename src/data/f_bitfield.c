@@ -18,16 +18,22 @@
 #include "f_bitfield.v.h"
 #include <faur.v.h>
 
-typedef unsigned long FChunk;
-#define F__BITS_PER_CHUNK (unsigned)(sizeof(FChunk) * 8)
+#define F__BITS_PER_CHUNK (unsigned)(sizeof(FBitfieldChunk) * 8)
 #define f__BITS_PER_CHUNK_MASK (F__BITS_PER_CHUNK - 1)
 
-struct FBitfield {
-    unsigned numChunks;
-    FChunk bits[];
-};
+static inline FBitfieldChunk* chunksGet(FBitfield* Bitfield)
+{
+    return Bitfield->numChunks <= F_BITFIELD__INLINE_CHUNKS
+            ? Bitfield->u.local : Bitfield->u.heap;
+}
 
-FBitfield* f_bitfield_new(unsigned NumBits)
+static inline const FBitfieldChunk* chunksGetConst(const FBitfield* Bitfield)
+{
+    return Bitfield->numChunks <= F_BITFIELD__INLINE_CHUNKS
+            ? Bitfield->u.local : Bitfield->u.heap;
+}
+
+void f_bitfield__init(FBitfield* Bitfield, unsigned NumBits)
 {
     #if F_CONFIG_DEBUG
         if(NumBits < 1) {
@@ -36,51 +42,139 @@ FBitfield* f_bitfield_new(unsigned NumBits)
     #endif
 
     unsigned numChunks = (NumBits + F__BITS_PER_CHUNK - 1) / F__BITS_PER_CHUNK;
-    FBitfield* b = f_mem_mallocz(
-                    sizeof(FBitfield) + numChunks * sizeof(FChunk));
 
-    b->numChunks = numChunks;
+    Bitfield->numChunks = numChunks;
+
+    if(numChunks <= F_BITFIELD__INLINE_CHUNKS) {
+        memset(Bitfield->u.local, 0, sizeof(Bitfield->u.local));
+    } else {
+        Bitfield->u.heap = f_mem_mallocz(numChunks * sizeof(FBitfieldChunk));
+    }
+}
+
+void f_bitfield__uninit(FBitfield* Bitfield)
+{
+    if(Bitfield->numChunks > F_BITFIELD__INLINE_CHUNKS) {
+        f_mem_free(Bitfield->u.heap);
+    }
+}
+
+FBitfield* f_bitfield_new(unsigned NumBits)
+{
+    FBitfield* b = f_mem_malloc(sizeof(FBitfield));
+
+    f_bitfield__init(b, NumBits);
 
     return b;
 }
 
 void f_bitfield_free(FBitfield* Bitfield)
 {
+    if(Bitfield == NULL) {
+        return;
+    }
+
+    f_bitfield__uninit(Bitfield);
     f_mem_free(Bitfield);
 }
 
 void f_bitfield_set(FBitfield* Bitfield, unsigned Bit)
 {
-    FChunk bit = (FChunk)1 << (Bit & f__BITS_PER_CHUNK_MASK);
-    Bitfield->bits[Bit / F__BITS_PER_CHUNK] |= bit;
+    FBitfieldChunk bit = (FBitfieldChunk)1 << (Bit & f__BITS_PER_CHUNK_MASK);
+
+    chunksGet(Bitfield)[Bit / F__BITS_PER_CHUNK] |= bit;
+}
+
+void f_bitfield_setMask(FBitfield* Bitfield, const FBitfield* Mask)
+{
+    FBitfieldChunk* b = chunksGet(Bitfield);
+    const FBitfieldChunk* m = chunksGetConst(Mask);
+
+    for(unsigned i = 0; i < Mask->numChunks; i++) {
+        b[i] |= m[i];
+    }
 }
 
 void f_bitfield_clear(FBitfield* Bitfield, unsigned Bit)
 {
-    FChunk bit = (FChunk)1 << (Bit & f__BITS_PER_CHUNK_MASK);
-    Bitfield->bits[Bit / F__BITS_PER_CHUNK] &= ~bit;
+    FBitfieldChunk bit = (FBitfieldChunk)1 << (Bit & f__BITS_PER_CHUNK_MASK);
+
+    chunksGet(Bitfield)[Bit / F__BITS_PER_CHUNK] &= ~bit;
+}
+
+void f_bitfield_clearMask(FBitfield* Bitfield, const FBitfield* Mask)
+{
+    FBitfieldChunk* b = chunksGet(Bitfield);
+    const FBitfieldChunk* m = chunksGetConst(Mask);
+
+    for(unsigned i = 0; i < Mask->numChunks; i++) {
+        b[i] &= ~m[i];
+    }
 }
 
 void f_bitfield_reset(FBitfield* Bitfield)
 {
-    memset(Bitfield->bits, 0, Bitfield->numChunks * sizeof(FChunk));
+    memset(chunksGet(Bitfield), 0, Bitfield->numChunks * sizeof(FBitfieldChunk));
 }
 
 bool f_bitfield_test(const FBitfield* Bitfield, unsigned Bit)
 {
-    FChunk value = Bitfield->bits[Bit / F__BITS_PER_CHUNK];
-    FChunk bit = (FChunk)1 << (Bit & f__BITS_PER_CHUNK_MASK);
+    FBitfieldChunk value = chunksGetConst(Bitfield)[Bit / F__BITS_PER_CHUNK];
+    FBitfieldChunk bit = (FBitfieldChunk)1 << (Bit & f__BITS_PER_CHUNK_MASK);
 
     return (value & bit) != 0;
 }
 
+// The mask loops below accumulate without branching so the compiler can
+// vectorize them on targets that have SIMD, and unroll the inline case
+
 bool f_bitfield_testMask(const FBitfield* Bitfield, const FBitfield* Mask)
 {
-    for(unsigned i = Mask->numChunks; i--; ) {
-        if((Bitfield->bits[i] & Mask->bits[i]) != Mask->bits[i]) {
-            return false;
-        }
+    const FBitfieldChunk* b = chunksGetConst(Bitfield);
+    const FBitfieldChunk* m = chunksGetConst(Mask);
+    FBitfieldChunk missing = 0;
+
+    for(unsigned i = 0; i < Mask->numChunks; i++) {
+        missing |= m[i] & ~b[i];
+    }
+
+    return missing == 0;
+}
+
+bool f_bitfield_testAny(const FBitfield* Bitfield, const FBitfield* Mask)
+{
+    const FBitfieldChunk* b = chunksGetConst(Bitfield);
+    const FBitfieldChunk* m = chunksGetConst(Mask);
+    FBitfieldChunk common = 0;
+
+    for(unsigned i = 0; i < Mask->numChunks; i++) {
+        common |= m[i] & b[i];
+    }
+
+    return common != 0;
+}
+
+bool f_bitfield_testEqual(const FBitfield* Bitfield, const FBitfield* Mask)
+{
+    const FBitfieldChunk* b = chunksGetConst(Bitfield);
+    const FBitfieldChunk* m = chunksGetConst(Mask);
+    FBitfieldChunk diff = 0;
+
+    for(unsigned i = 0; i < Mask->numChunks; i++) {
+        diff |= m[i] ^ b[i];
+    }
+
+    return diff == 0;
+}
+
+unsigned f_bitfield_countGet(const FBitfield* Bitfield)
+{
+    const FBitfieldChunk* b = chunksGetConst(Bitfield);
+    unsigned count = 0;
+
+    for(unsigned i = 0; i < Bitfield->numChunks; i++) {
+        count += (unsigned)__builtin_popcountl(b[i]);
     }
 
-    return true;
+    return count;
 }
@@ -26,10 +26,16 @@ extern FBitfield* f_bitfield_new(unsigned NumBits);
 extern void f_bitfield_free(FBitfield* Bitfield);
 
 extern void f_bitfield_set(FBitfield* Bitfield, unsigned Bit);
+extern void f_bitfield_setMask(FBitfield* Bitfield, const FBitfield* Mask);
 extern void f_bitfield_clear(FBitfield* Bitfield, unsigned Bit);
+extern void f_bitfield_clearMask(FBitfield* Bitfield, const FBitfield* Mask);
 extern void f_bitfield_reset(FBitfield* Bitfield);
 
 extern bool f_bitfield_test(const FBitfield* Bitfield, unsigned Bit);
 extern bool f_bitfield_testMask(const FBitfield* Bitfield, const FBitfield* Mask);
+extern bool f_bitfield_testAny(const FBitfield* Bitfield, const FBitfield* Mask);
+extern bool f_bitfield_testEqual(const FBitfield* Bitfield, const FBitfield* Mask);
+
+extern unsigned f_bitfield_countGet(const FBitfield* Bitfield);
 
 #endif // F_INC_DATA_BITFIELD_P_H
@@ -20,4 +20,26 @@
 
 #include "f_bitfield.p.h"
 
+typedef unsigned long FBitfieldChunk;
+
+#if F_CONFIG_TRAIT_LOW_MEM
+    #define F_BITFIELD__INLINE_BITS 64
+#else
+    #define F_BITFIELD__INLINE_BITS 128
+#endif
+
+#define F_BITFIELD__INLINE_CHUNKS \
+    (F_BITFIELD__INLINE_BITS / (sizeof(FBitfieldChunk) * 8))
+
+struct FBitfield {
+    unsigned numChunks;
+    union {
+        FBitfieldChunk local[F_BITFIELD__INLINE_CHUNKS]; // if it fits
+        FBitfieldChunk* heap; // [numChunks] otherwise
+    } u;
+};
+
+extern void f_bitfield__init(FBitfield* Bitfield, unsigned NumBits);
+extern void f_bitfield__uninit(FBitfield* Bitfield);
+
 #endif // F_INC_DATA_BITFIELD_V_H
@@ -18,14 +18,26 @@
 #include "f_hash.v.h"
 #include <faur.v.h>
 
+// Grow the slots array past this load, in 1/8ths
+#define F__MAX_LOAD 7
+
+#define F__SLOT_EMPTY UINT_MAX
+
+typedef struct {
+    unsigned hash; // cached hashGet(key)
+    unsigned entry; // index into entries array, or F__SLOT_EMPTY
+} FHashSlot;
+
 struct FHash {
     FCallHashFunction* function;
     FCallHashEqual* keyEqual;
     FCallFree* keyFree;
-    unsigned numSlots;
-    unsigned numEntries;
-    FListIntr entries; // FListIntr<F__HashEntry*>
-    F__HashEntry* slots[]; // [numSlots]
+    FHashSlot* slots; // [slotsNum] Robin Hood linear probing table
+    unsigned slotsNum; // power of 2
+    F__HashEntry* entries; // [entriesCapacity] insertion order, with holes
+    unsigned entriesNum; // used length of entries array, including holes
+    unsigned entriesCapacity; // allocated length of entries array
+    unsigned numEntries; // live entries
 };
 
 #if F_CONFIG_BUILD_GEN_LUTS
@@ -72,12 +84,7 @@ static bool keyEqual(const void* KeyA, const void* KeyB)
     return KeyA == KeyB;
 }
 
-static inline unsigned getSlot(const FHash* Hash, const void* Key)
-{
-    return Hash->function(Key) & (Hash->numSlots - 1);
-}
-
-static unsigned func_djb2(const char* Key)
+unsigned f_hash__strHash(const char* Key)
 {
     unsigned h = 5381;
 
@@ -88,6 +95,142 @@ static unsigned func_djb2(const char* Key)
     return h;
 }
 
+static inline unsigned hashMix(unsigned Hash)
+{
+    // Spread the user hash, slots are picked by its low bits
+    uint32_t h = (uint32_t)Hash;
+
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+
+    return h;
+}
+
+static inline unsigned hashGet(const FHash* Hash, const void* Key)
+{
+    return hashMix(Hash->function(Key));
+}
+
+static inline unsigned probeDistance(const FHash* Hash, const FHashSlot* Slot, unsigned Index)
+{
+    return (Index - Slot->hash) & (Hash->slotsNum - 1);
+}
+
+static void slotInsert(FHash* Hash, unsigned Hash32, unsigned Entry)
+{
+    unsigned mask = Hash->slotsNum - 1;
+    FHashSlot slot = {Hash32, Entry};
+
+    for(unsigned i = Hash32 & mask, dist = 0; ; i = (i + 1) & mask, dist++) {
+        FHashSlot* s = &Hash->slots[i];
+
+        if(s->entry == F__SLOT_EMPTY) {
+            *s = slot;
+
+            return;
+        }
+
+        unsigned sDist = probeDistance(Hash, s, i);
+
+        // Take from the rich, entries closer to home move along
+        if(sDist < dist) {
+            FHashSlot tmp = *s;
+
+            *s = slot;
+            slot = tmp;
+            dist = sDist;
+        }
+    }
+}
+
+static void slotsRebuild(FHash* Hash, unsigned SlotsNum)
+{
+    if(SlotsNum != Hash->slotsNum) {
+        f_mem_free(Hash->slots);
+
+        Hash->slots = f_mem_malloc(SlotsNum * sizeof(FHashSlot));
+        Hash->slotsNum = SlotsNum;
+    }
+
+    for(unsigned i = SlotsNum; i--; ) {
+        Hash->slots[i].entry = F__SLOT_EMPTY;
+    }
+
+    // Hashes are cached, so this never calls the hash function
+    for(unsigned e = 0; e < Hash->entriesNum; e++) {
+        if(Hash->entries[e].key != NULL) {
+            slotInsert(Hash, Hash->entries[e].hash, e);
+        }
+    }
+}
+
+static void entriesCompact(FHash* Hash)
+{
+    unsigned live = 0;
+
+    for(unsigned e = 0; e < Hash->entriesNum; e++) {
+        if(Hash->entries[e].key != NULL) {
+            Hash->entries[live++] = Hash->entries[e];
+        }
+    }
+
+    Hash->entriesNum = live;
+}
+
+static unsigned slotFind(const FHash* Hash, const void* Key, unsigned Hash32)
+{
+    unsigned mask = Hash->slotsNum - 1;
+
+    for(unsigned i = Hash32 & mask, dist = 0; ; i = (i + 1) & mask, dist++) {
+        const FHashSlot* s = &Hash->slots[i];
+
+        if(s->entry == F__SLOT_EMPTY || probeDistance(Hash, s, i) < dist) {
+            return F__SLOT_EMPTY;
+        }
+
+        if(s->hash == Hash32) {
+            const void* key = Hash->entries[s->entry].key;
+
+            // Interned keys match by pointer and skip keyEqual
+            if(key == Key || Hash->keyEqual(Key, key)) {
+                return i;
+            }
+        }
+    }
+}
+
+static void slotRemove(FHash* Hash, unsigned Slot)
+{
+    unsigned mask = Hash->slotsNum - 1;
+    F__HashEntry* e = &Hash->entries[Hash->slots[Slot].entry];
+
+    if(Hash->keyFree) {
+        Hash->keyFree((void*)e->key);
+    }
+
+    e->key = NULL;
+    e->content = NULL;
+
+    // Backward shift, so lookups never need tombstones
+    for(unsigned next = (Slot + 1) & mask; ; next = (next + 1) & mask) {
+        FHashSlot* s = &Hash->slots[next];
+
+        if(s->entry == F__SLOT_EMPTY || probeDistance(Hash, s, next) == 0) {
+            break;
+        }
+
+        Hash->slots[Slot] = *s;
+        Slot = next;
+    }
+
+    Hash->slots[Slot].entry = F__SLOT_EMPTY;
+
+    if(--Hash->numEntries == 0) {
+        Hash->entriesNum = 0;
+    }
+}
+
 FHash* f_hash_new(FCallHashFunction* Function, FCallHashEqual* KeyEqual, FCallFree* KeyFree, unsigned NumSlots)
 {
     #if F_CONFIG_DEBUG
@@ -96,31 +239,28 @@ FHash* f_hash_new(FCallHashFunction* Function, FCallHashEqual* KeyEqual, FCallFr
         }
     #endif
 
-    if((NumSlots & (NumSlots - 1)) != 0) {
-        unsigned slots = 1;
+    unsigned slots = 8;
 
-        while(slots < NumSlots) {
-            slots <<= 1;
-        }
-
-        NumSlots = slots;
+    while(slots < NumSlots) {
+        slots <<= 1;
     }
 
-    FHash* h = f_mem_mallocz(sizeof(FHash) + NumSlots * sizeof(F__HashEntry*));
+    FHash* h = f_mem_mallocz(sizeof(FHash));
 
     h->function = Function;
     h->keyEqual = KeyEqual ? KeyEqual : keyEqual;
     h->keyFree = KeyFree;
-    h->numSlots = NumSlots;
+    h->entriesCapacity = slots * F__MAX_LOAD / 8;
+    h->entries = f_mem_malloc(h->entriesCapacity * sizeof(F__HashEntry));
 
-    f_listintr_init(&h->entries, F__HashEntry, listNode);
+    slotsRebuild(h, slots);
 
     return h;
 }
 
 FHash* f_hash_newStr(unsigned NumSlots, bool FreeKeyString)
 {
-    return f_hash_new((FCallHashFunction*)func_djb2,
+    return f_hash_new((FCallHashFunction*)f_hash__strHash,
                       (FCallHashEqual*)f_str_equal,
                       FreeKeyString ? f_mem_free : NULL,
                       NumSlots);
@@ -137,101 +277,116 @@ void f_hash_freeEx(FHash* Hash, FCallFree* Free)
         return;
     }
 
-    F_LISTINTR_ITERATE(&Hash->entries, F__HashEntry*, e) {
+    for(unsigned e = 0; e < Hash->entriesNum; e++) {
+        const F__HashEntry* entry = &Hash->entries[e];
+
+        if(entry->key == NULL) {
+            continue;
+        }
+
         if(Free) {
-            Free(e->content);
+            Free(entry->content);
         }
 
         if(Hash->keyFree) {
-            Hash->keyFree((void*)e->key);
+            Hash->keyFree((void*)entry->key);
         }
-
-        f_pool_release(e);
     }
 
+    f_mem_free(Hash->slots);
+    f_mem_free(Hash->entries);
     f_mem_free(Hash);
 }
 
 void f_hash_add(FHash* Hash, const void* Key, void* Content)
 {
-    unsigned slot = getSlot(Hash, Key);
-
     #if F_CONFIG_DEBUG
-        for(F__HashEntry* e = Hash->slots[slot]; e; e = e->next) {
-            if(Hash->keyEqual(Key, e->key)) {
-                F__FATAL("f_hash_add: Key already in table");
-            }
+        if(Key == NULL) {
+            F__FATAL("f_hash_add: NULL key");
         }
     #endif
 
-    F__HashEntry* oldEntry = Hash->slots[slot];
-    F__HashEntry* newEntry = f_pool__alloc(F_POOL__HASHENTRY);
+    unsigned hash = hashGet(Hash, Key);
 
-    newEntry->next = oldEntry;
-    newEntry->key = Key;
-    newEntry->content = Content;
+    #if F_CONFIG_DEBUG
+        if(slotFind(Hash, Key, hash) != F__SLOT_EMPTY) {
+            F__FATAL("f_hash_add: Key already in table");
+        }
+    #endif
 
-    Hash->slots[slot] = newEntry;
-    f_listintr_addLast(&Hash->entries, newEntry);
-    Hash->numEntries++;
-}
+    if(Hash->entriesNum == Hash->entriesCapacity) {
+        if(Hash->numEntries <= Hash->entriesNum / 2) {
+            // At least half are holes, squeeze them out instead of growing
+            entriesCompact(Hash);
+            slotsRebuild(Hash, Hash->slotsNum);
+        } else {
+            F__HashEntry* entries =
+                f_mem_malloc(2 * Hash->entriesCapacity * sizeof(F__HashEntry));
 
-void* f_hash_update(FHash* Hash, const void* Key, void* NewContent)
-{
-    unsigned slot = getSlot(Hash, Key);
+            memcpy(entries,
+                   Hash->entries,
+                   Hash->entriesNum * sizeof(F__HashEntry));
 
-    for(F__HashEntry* e = Hash->slots[slot]; e; e = e->next) {
-        if(Hash->keyEqual(Key, e->key)) {
-            void* oldContent = e->content;
-            e->content = NewContent;
+            f_mem_free(Hash->entries);
 
-            return oldContent;
+            Hash->entries = entries;
+            Hash->entriesCapacity *= 2;
         }
     }
 
-    return NULL;
+    if((Hash->numEntries + 1) * 8 > Hash->slotsNum * F__MAX_LOAD) {
+        slotsRebuild(Hash, Hash->slotsNum * 2);
+    }
+
+    F__HashEntry* e = &Hash->entries[Hash->entriesNum];
+
+    e->key = Key;
+    e->content = Content;
+    e->hash = hash;
+
+    slotInsert(Hash, hash, Hash->entriesNum++);
+    Hash->numEntries++;
 }
 
-static void removeEntry(FHash* Hash, unsigned Slot, F__HashEntry* Current, F__HashEntry* Previous)
+void* f_hash_update(FHash* Hash, const void* Key, void* NewContent)
 {
-    if(Previous == NULL) {
-        Hash->slots[Slot] = Current->next;
-    } else {
-        Previous->next = Current->next;
+    unsigned slot = slotFind(Hash, Key, hashGet(Hash, Key));
+
+    if(slot == F__SLOT_EMPTY) {
+        return NULL;
     }
 
-    f_listintr_removeNode(&Current->listNode);
-    Hash->numEntries--;
+    F__HashEntry* e = &Hash->entries[Hash->slots[slot].entry];
+    void* oldContent = e->content;
 
-    if(Hash->keyFree) {
-        Hash->keyFree((void*)Current->key);
-    }
+    e->content = NewContent;
 
-    f_pool_release(Current);
+    return oldContent;
 }
 
 void f_hash_removeKey(FHash* Hash, const void* Key)
 {
-    unsigned slot = getSlot(Hash, Key);
-    F__HashEntry* prev = NULL;
+    unsigned slot = slotFind(Hash, Key, hashGet(Hash, Key));
 
-    for(F__HashEntry* e = Hash->slots[slot]; e; prev = e, e = e->next) {
-        if(Hash->keyEqual(Key, e->key)) {
-            removeEntry(Hash, slot, e, prev);
-
-            return;
-        }
+    if(slot != F__SLOT_EMPTY) {
+        slotRemove(Hash, slot);
     }
 }
 
 void f_hash_removeItem(FHash* Hash, const void* Content)
 {
-    for(unsigned slot = Hash->numSlots; slot--; ) {
-        F__HashEntry* prev = NULL;
+    for(unsigned e = 0; e < Hash->entriesNum; e++) {
+        const F__HashEntry* entry = &Hash->entries[e];
+
+        if(entry->key == NULL || entry->content != Content) {
+            continue;
+        }
 
-        for(F__HashEntry* e = Hash->slots[slot]; e; prev = e, e = e->next) {
-            if(e->content == Content) {
-                removeEntry(Hash, slot, e, prev);
+        unsigned mask = Hash->slotsNum - 1;
+
+        for(unsigned i = entry->hash & mask; ; i = (i + 1) & mask) {
+            if(Hash->slots[i].entry == e) {
+                slotRemove(Hash, i);
 
                 return;
             }
@@ -241,28 +396,45 @@ void f_hash_removeItem(FHash* Hash, const void* Content)
 
 void* f_hash_get(const FHash* Hash, const void* Key)
 {
-    unsigned slot = getSlot(Hash, Key);
+    unsigned slot = slotFind(Hash, Key, hashGet(Hash, Key));
 
-    for(F__HashEntry* e = Hash->slots[slot]; e; e = e->next) {
-        if(Hash->keyEqual(Key, e->key)) {
-            return e->content;
-        }
+    if(slot == F__SLOT_EMPTY) {
+        return NULL;
     }
 
-    return NULL;
+    return Hash->entries[Hash->slots[slot].entry].content;
 }
 
 bool f_hash_contains(const FHash* Hash, const void* Key)
 {
-    unsigned slot = getSlot(Hash, Key);
+    return slotFind(Hash, Key, hashGet(Hash, Key)) != F__SLOT_EMPTY;
+}
 
-    for(F__HashEntry* e = Hash->slots[slot]; e; e = e->next) {
-        if(Hash->keyEqual(Key, e->key)) {
-            return true;
+static unsigned slotFindStrId(const FHash* Hash, const FStrId* Id)
+{
+    #if F_CONFIG_DEBUG
+        if(Hash->function != (FCallHashFunction*)f_hash__strHash) {
+            F__FATAL("f_hash: FStrId lookup needs an f_hash_newStr table");
         }
+    #endif
+
+    return slotFind(Hash, Id->string, hashMix(Id->hash));
+}
+
+void* f_hash_getStrId(const FHash* Hash, const FStrId* Id)
+{
+    unsigned slot = slotFindStrId(Hash, Id);
+
+    if(slot == F__SLOT_EMPTY) {
+        return NULL;
     }
 
-    return false;
+    return Hash->entries[Hash->slots[slot].entry].content;
+}
+
+bool f_hash_containsStrId(const FHash* Hash, const FStrId* Id)
+{
+    return slotFindStrId(Hash, Id) != F__SLOT_EMPTY;
 }
 
 unsigned f_hash_sizeGet(const FHash* Hash)
@@ -272,80 +444,100 @@ unsigned f_hash_sizeGet(const FHash* Hash)
 
 void** f_hash_toArray(const FHash* Hash)
 {
+    unsigned i = 0;
     void** array = f_mem_malloc(Hash->numEntries * sizeof(void*));
 
-    F_LISTINTR_ITERATE(&Hash->entries, const F__HashEntry*, e) {
-        array[F_LISTINTR_INDEX()] = e->content;
+    for(unsigned e = 0; e < Hash->entriesNum; e++) {
+        if(Hash->entries[e].key != NULL) {
+            array[i++] = Hash->entries[e].content;
+        }
     }
 
     return array;
 }
 
-const FListIntr* f__hash_entries(const FHash* Hash)
+F__HashIt f__hashit_new(const FHash* Hash)
 {
-    return &Hash->entries;
+    F__HashIt it = {Hash, 0, NULL};
+
+    return it;
 }
 
-void* f__hash_entryValue(const F__HashEntry* Entry)
+static const F__HashEntry* itNext(F__HashIt* Iterator)
 {
-    return Entry->content;
+    const FHash* hash = Iterator->hash;
+
+    while(Iterator->index < hash->entriesNum) {
+        const F__HashEntry* e = &hash->entries[Iterator->index++];
+
+        if(e->key != NULL) {
+            Iterator->key = e->key;
+
+            return e;
+        }
+    }
+
+    return NULL;
 }
 
-const void* f__hash_entryKey(const F__HashEntry* Entry)
+bool f__hashit_getNext(F__HashIt* Iterator, void* UserPtrAddress)
 {
-    return Entry->key;
+    const F__HashEntry* e = itNext(Iterator);
+
+    if(e == NULL) {
+        return false;
+    }
+
+    *(void**)UserPtrAddress = e->content;
+
+    return true;
 }
 
-void f__hash_printStats(const FHash* Hash, const char* Message)
+bool f__hashit_getNextKey(F__HashIt* Iterator, void* UserPtrAddress)
 {
-    unsigned occupiedSlots = 0, slotsWithCollisions = 0, collisions = 0;
-    unsigned minLength = UINT_MAX, maxLength = 0, lengthSum = 0;
+    const F__HashEntry* e = itNext(Iterator);
 
-    for(unsigned slot = 0; slot < Hash->numSlots; slot++) {
-        unsigned entriesInSlot = 0;
+    if(e == NULL) {
+        return false;
+    }
 
-        for(F__HashEntry* e = Hash->slots[slot]; e; e = e->next) {
-            entriesInSlot++;
-        }
+    *(const void**)UserPtrAddress = e->key;
 
-        if(entriesInSlot > 0) {
-            occupiedSlots++;
-            lengthSum += entriesInSlot;
+    return true;
+}
 
-            if(entriesInSlot > 1) {
-                slotsWithCollisions++;
-                collisions += entriesInSlot - 1;
-            }
+void f__hash_printStats(const FHash* Hash, const char* Message)
+{
+    unsigned distSum = 0, distMax = 0;
 
-            if(entriesInSlot < minLength) {
-                minLength = entriesInSlot;
-            }
+    for(unsigned i = 0; i < Hash->slotsNum; i++) {
+        const FHashSlot* s = &Hash->slots[i];
 
-            if(entriesInSlot > maxLength) {
-                maxLength = entriesInSlot;
-            }
+        if(s->entry != F__SLOT_EMPTY) {
+            unsigned dist = probeDistance(Hash, s, i);
+
+            distSum += dist;
+            distMax = f_math_maxu(distMax, dist);
         }
     }
 
     printf("%s: ", Message);
 
-    if(occupiedSlots == 0) {
+    if(Hash->numEntries == 0) {
         printf("empty\n");
 
         return;
     }
 
-    printf("%d/%d (%d%%) slots used, %d/%d (%d%%) entries collide, "
-           "chain min=%d avg=%.2f max=%d\n",
-           occupiedSlots,
-           Hash->numSlots,
-           100 * occupiedSlots / Hash->numSlots,
-           collisions,
+    printf("%u/%u (%u%%) slots used, %u/%u entries live, "
+           "probe avg=%.2f max=%u\n",
+           Hash->numEntries,
+           Hash->slotsNum,
+           100 * Hash->numEntries / Hash->slotsNum,
            Hash->numEntries,
-           100 * collisions / Hash->numEntries,
-           minLength,
-           (float)lengthSum / (float)occupiedSlots,
-           maxLength);
+           Hash->entriesNum,
+           (float)distSum / (float)Hash->numEntries,
+           distMax);
 }
 
 uint8_t f_hash_crc8(const void* Buffer, size_t Size)
@@ -24,11 +24,12 @@
 
 extern const FPack f_pack__hash;
 
+extern unsigned f_hash__strHash(const char* Key);
+
 struct F__HashEntry {
-    FListIntrNode listNode;
-    F__HashEntry* next;
-    const void* key;
+    const void* key; // NULL if removed
     void* content;
+    unsigned hash; // cached, mixed hash of key
 };
 
 #endif // F_INC_DATA_HASH_V_H
@@ -71,7 +71,7 @@ void f_list_freeEx(FList* List, FCallFree* Free)
 
 FListNode* f_list_addFirst(FList* List, void* Content)
 {
-    FListNode* n = f_pool__alloc(F_POOL__LISTNODE);
+    FListNode* n = f_pool__allocRaw(F_POOL__LISTNODE);
 
     n->content = Content;
     n->list = List;
@@ -88,7 +88,7 @@ FListNode* f_list_addFirst(FList* List, void* Content)
 
 FListNode* f_list_addLast(FList* List, void* Content)
 {
-    FListNode* n = f_pool__alloc(F_POOL__LISTNODE);
+    FListNode* n = f_pool__allocRaw(F_POOL__LISTNODE);
 
     n->content = Content;
     n->list = List;
@@ -302,16 +302,25 @@ FList* f_list_dup(const FList* List)
     return l;
 }
 
-void** f_list_toArray(const FList* List)
+static void** toArray(const FList* List, void** Array)
 {
     int i = 0;
-    void** array = f_mem_malloc(List->items * sizeof(void*));
 
     F__ITERATE(List, n) {
-        array[i++] = n->content;
+        Array[i++] = n->content;
     }
 
-    return array;
+    return Array;
+}
+
+void** f_list_toArray(const FList* List)
+{
+    return toArray(List, f_mem_malloc(List->items * sizeof(void*)));
+}
+
+void** f_list_toArrayFrame(const FList* List)
+{
+    return toArray(List, f_arena_frameAlloc(List->items * sizeof(void*)));
 }
 
 void f_list_reverse(FList* List)
@@ -329,98 +338,193 @@ void f_list_reverse(FList* List)
     List->sentinel.prev = save;
 }
 
-static inline FListNode* getNode(FListNode* Start, unsigned Index)
+#define F__SORT_INSERTION_MAX 16
+
+static inline int nodeCmp(FCallListCompare* Compare, const void* A, const void* B)
 {
-    while(Index--) {
-        Start = Start->next;
-    }
+    return Compare(((const FListNode*)A)->content,
+                   ((const FListNode*)B)->content);
+}
 
-    return Start;
+static int nodeCmpMerge(void* Context, const void* A, const void* B)
+{
+    return nodeCmp(*(FCallListCompare**)Context, A, B);
 }
 
-static inline void addHeadToMerged(FListNode** MergedTail, FListNode** SortedHead)
+static void sortInsertion(void** Nodes, unsigned Num, FCallListCompare* Compare)
 {
-    FListNode* nextSortedHead = (*SortedHead)->next;
+    for(unsigned i = 1; i < Num; i++) {
+        FListNode* n = Nodes[i];
+        unsigned j = i;
 
-    if(nextSortedHead != NULL) {
-        nextSortedHead->prev = NULL;
+        while(j > 0 && nodeCmp(Compare, Nodes[j - 1], n) > 0) {
+            Nodes[j] = Nodes[j - 1];
+            j--;
+        }
+
+        Nodes[j] = n;
     }
+}
 
-    (*MergedTail)->next = *SortedHead;
-    (*SortedHead)->prev = (*MergedTail);
-    (*SortedHead)->next = NULL;
+static void sortHeapSift(void** Nodes, unsigned Root, unsigned Num, FCallListCompare* Compare)
+{
+    FListNode* n = Nodes[Root];
 
-    *MergedTail = *SortedHead;
-    *SortedHead = nextSortedHead;
+    for(unsigned child; (child = 2 * Root + 1) < Num; Root = child) {
+        if(child + 1 < Num
+            && nodeCmp(Compare, Nodes[child], Nodes[child + 1]) < 0) {
+
+            child++;
+        }
+
+        if(nodeCmp(Compare, n, Nodes[child]) >= 0) {
+            break;
+        }
+
+        Nodes[Root] = Nodes[child];
+    }
+
+    Nodes[Root] = n;
 }
 
-static FListNode* sort(FListNode* Start, unsigned Length, FCallListCompare* Compare)
+static void sortHeap(void** Nodes, unsigned Num, FCallListCompare* Compare)
 {
-    if(Length == 1) {
-        return Start;
+    for(unsigned i = Num / 2; i--; ) {
+        sortHeapSift(Nodes, i, Num, Compare);
     }
 
-    unsigned halfPoint = Length / 2;
+    for(unsigned i = Num; i-- > 1; ) {
+        FListNode* n = Nodes[0];
 
-    FListNode* firstHalfHead = getNode(Start, 0);
-    FListNode* secondHalfHead = getNode(Start, halfPoint);
+        Nodes[0] = Nodes[i];
+        Nodes[i] = n;
 
-    secondHalfHead->prev->next = NULL;
-    secondHalfHead->prev = NULL;
+        sortHeapSift(Nodes, 0, i, Compare);
+    }
+}
 
-    // sort [0, halfPoint) and [halfPoint, Length)
-    FListNode* a = sort(firstHalfHead, halfPoint, Compare);
-    FListNode* b = sort(secondHalfHead, Length - halfPoint, Compare);
+static void sortIntro(void** Nodes, unsigned Num, unsigned DepthLeft, FCallListCompare* Compare)
+{
+    while(Num > F__SORT_INSERTION_MAX) {
+        if(DepthLeft-- == 0) {
+            // Too many bad pivots, heap sort bounds this at n log n
+            sortHeap(Nodes, Num, Compare);
 
-    FListNode mergedHead = {NULL, NULL, NULL, NULL};
-    FListNode* mergedTail = &mergedHead;
+            return;
+        }
 
-    // Merge a and b
-    while(true) {
-        if(a == NULL) {
-            mergedTail->next = b;
-            b->prev = mergedTail;
-            break;
+        // Median of three, leaves first <= mid <= last
+        void** a = &Nodes[0];
+        void** m = &Nodes[Num / 2];
+        void** z = &Nodes[Num - 1];
+        FListNode* t;
+
+        if(nodeCmp(Compare, *m, *a) < 0) {
+            t = *m; *m = *a; *a = t;
         }
 
-        if(b == NULL) {
-            mergedTail->next = a;
-            a->prev = mergedTail;
-            break;
+        if(nodeCmp(Compare, *z, *m) < 0) {
+            t = *z; *z = *m; *m = t;
+
+            if(nodeCmp(Compare, *m, *a) < 0) {
+                t = *m; *m = *a; *a = t;
+            }
+        }
+
+        // Hoare partition around the median, first and last are sentinels
+        FListNode* pivot = *m;
+        unsigned i = 0;
+        unsigned j = Num - 1;
+
+        while(true) {
+            while(nodeCmp(Compare, Nodes[++i], pivot) < 0) {
+                continue;
+            }
+
+            while(nodeCmp(Compare, pivot, Nodes[--j]) < 0) {
+                continue;
+            }
+
+            if(i >= j) {
+                break;
+            }
+
+            t = Nodes[i];
+            Nodes[i] = Nodes[j];
+            Nodes[j] = t;
         }
 
-        int result = Compare(a->content, b->content);
+        // Recurse into the smaller side, loop on the larger one
+        if(j + 1 < Num - j - 1) {
+            sortIntro(Nodes, j + 1, DepthLeft, Compare);
+
+            Nodes += j + 1;
+            Num -= j + 1;
+        } else {
+            sortIntro(Nodes + j + 1, Num - j - 1, DepthLeft, Compare);
 
-        if(result <= 0) {
-            addHeadToMerged(&mergedTail, &a);
-        } else if(result > 0) {
-            addHeadToMerged(&mergedTail, &b);
+            Num = j + 1;
         }
     }
 
-    return mergedHead.next;
+    sortInsertion(Nodes, Num, Compare);
 }
 
-void f_list_sort(FList* List, FCallListCompare* Compare)
+static void sortList(FList* List, FCallListCompare* Compare, bool Stable)
 {
-    if(List->items < 2) {
+    unsigned num = List->items;
+
+    if(num < 2) {
         return;
     }
 
-    List->sentinel.next->prev = NULL;
-    List->sentinel.prev->next = NULL;
+    // Stable sorts use the second half as merge scratch
+    void** buffer = f_mem_malloc((Stable ? 2 : 1) * num * sizeof(void*));
+    void** nodes = buffer;
+    unsigned i = 0;
 
-    FListNode* sorted = sort(List->sentinel.next, List->items, Compare);
+    F__ITERATE(List, n) {
+        nodes[i++] = n;
+    }
 
-    List->sentinel.next = sorted;
-    sorted->prev = &List->sentinel;
+    if(Stable) {
+        nodes = f_array__sortMerge(
+                    buffer, buffer + num, num, nodeCmpMerge, &Compare);
+    } else {
+        unsigned depth = 0;
+
+        for(unsigned n = num; n > 1; n /= 2) {
+            depth += 2;
+        }
+
+        sortIntro(nodes, num, depth, Compare);
+    }
+
+    // Relink the nodes in sorted order
+    FListNode* prev = &List->sentinel;
 
-    while(sorted->next != NULL) {
-        sorted = sorted->next;
+    for(i = 0; i < num; i++) {
+        FListNode* n = nodes[i];
+
+        prev->next = n;
+        n->prev = prev;
+        prev = n;
     }
 
-    sorted->next = &List->sentinel;
-    List->sentinel.prev = sorted;
+    prev->next = &List->sentinel;
+    List->sentinel.prev = prev;
+
+    f_mem_free(buffer);
+}
+
+void f_list_sort(FList* List, FCallListCompare* Compare)
+{
+    sortList(List, Compare, false);
+}
+
+void f_list_sortStable(FList* List, FCallListCompare* Compare)
+{
+    sortList(List, Compare, true);
 }
 
 unsigned f_list_sizeGet(const FList* List)
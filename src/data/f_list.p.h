@@ -52,9 +52,11 @@ extern void f_list_clearEx(FList* List, FCallFree* Free);
 
 extern FList* f_list_dup(const FList* List);
 extern void** f_list_toArray(const FList* List);
+extern void** f_list_toArrayFrame(const FList* List);
 
 extern void f_list_reverse(FList* List);
 extern void f_list_sort(FList* List, FCallListCompare* Compare);
+extern void f_list_sortStable(FList* List, FCallListCompare* Compare);
 
 extern unsigned f_list_sizeGet(const FList* List);
 extern bool f_list_sizeIsEmpty(const FList* List);
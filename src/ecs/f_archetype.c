@@ -0,0 +1,195 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "f_archetype.v.h"
+#include <faur.v.h>
+
+static FList* g_archetypes; // FList<FArchetype*>
+static FArchetype** g_rootNext; // [f_component__num] single-component archetypes
+
+static void* arrayGrow(void* Array, unsigned* Capacity, size_t ItemSize)
+{
+    unsigned newCapacity = *Capacity ? *Capacity * 2 : 8;
+    void* newArray = f_mem_malloc(newCapacity * ItemSize);
+
+    if(Array) {
+        memcpy(newArray, Array, *Capacity * ItemSize);
+        f_mem_free(Array);
+    }
+
+    *Capacity = newCapacity;
+
+    return newArray;
+}
+
+static FArchetype* archetypeNew(const FBitfield* ComponentBits)
+{
+    FArchetype* a = f_mem_mallocz(sizeof(FArchetype));
+
+    f_bitfield__init(&a->componentBits, f_component__num);
+    f_bitfield_setMask(&a->componentBits, ComponentBits);
+
+    a->next = f_mem_mallocz(f_component__num * sizeof(FArchetype*));
+    a->columnsNum = f_bitfield_countGet(ComponentBits);
+
+    a->columns = f_mem_malloc(a->columnsNum * sizeof(FArchetypeColumn));
+
+    for(unsigned c = 0, col = 0; c < f_component__num; c++) {
+        if(!f_bitfield_test(&a->componentBits, c)) {
+            continue;
+        }
+
+        FArchetypeColumn* column = &a->columns[col++];
+
+        column->component = f_component__array[c];
+        column->offset = a->chunkSize;
+        column->stride = (column->component->size
+                            + sizeof(FMaxMemAlignType) - 1)
+                                & ~(sizeof(FMaxMemAlignType) - 1);
+
+        a->chunkSize += column->stride * F_ARCHETYPE__CHUNK_ROWS;
+    }
+
+    // Every entity with this component set matches the same systems
+    a->systemsActive = f_array_new();
+    a->systemsRest = f_array_new();
+
+    for(unsigned s = f_system__num; s--; ) {
+        FSystem* system = f_system__array[s];
+
+        if(f_bitfield_testMask(&a->componentBits, &system->componentBits)) {
+            if(system->onlyActiveEntities) {
+                f_array_add(a->systemsActive, system);
+            } else {
+                f_array_add(a->systemsRest, system);
+            }
+        }
+    }
+
+    f_list_addLast(g_archetypes, a);
+
+    return a;
+}
+
+static void archetypeFree(FArchetype* Archetype)
+{
+    for(unsigned c = Archetype->chunksNum; c--; ) {
+        f_mem_free(Archetype->chunks[c]);
+    }
+
+    f_mem_free(Archetype->chunks);
+    f_mem_free(Archetype->freeRows);
+    f_mem_free(Archetype->columns);
+    f_mem_free(Archetype->next);
+    f_array_free(Archetype->systemsActive);
+    f_array_free(Archetype->systemsRest);
+    f_bitfield__uninit(&Archetype->componentBits);
+
+    f_mem_free(Archetype);
+}
+
+void f_archetype__init(void)
+{
+    g_archetypes = f_list_new();
+    g_rootNext = f_mem_mallocz(f_component__num * sizeof(FArchetype*));
+}
+
+void f_archetype__uninit(void)
+{
+    f_list_freeEx(g_archetypes, (FCallFree*)archetypeFree);
+    f_mem_free(g_rootNext);
+}
+
+FArchetype* f_archetype__get(const FBitfield* ComponentBits)
+{
+    if(f_bitfield_countGet(ComponentBits) == 0) {
+        return NULL;
+    }
+
+    F_LIST_ITERATE(g_archetypes, FArchetype*, a) {
+        if(f_bitfield_testEqual(&a->componentBits, ComponentBits)) {
+            return a;
+        }
+    }
+
+    return archetypeNew(ComponentBits);
+}
+
+FArchetype* f_archetype__getNext(FArchetype* Archetype, const FComponent* Component)
+{
+    FArchetype** next = Archetype ? Archetype->next : g_rootNext;
+
+    if(next[Component->bitId] == NULL) {
+        FBitfield bits;
+
+        f_bitfield__init(&bits, f_component__num);
+
+        if(Archetype) {
+            f_bitfield_setMask(&bits, &Archetype->componentBits);
+        }
+
+        f_bitfield_set(&bits, Component->bitId);
+
+        next[Component->bitId] = f_archetype__get(&bits);
+
+        f_bitfield__uninit(&bits);
+    }
+
+    return next[Component->bitId];
+}
+
+unsigned f_archetype__rowNew(FArchetype* Archetype)
+{
+    unsigned row;
+
+    if(Archetype->freeRowsNum > 0) {
+        row = Archetype->freeRows[--Archetype->freeRowsNum];
+
+        for(unsigned c = Archetype->columnsNum; c--; ) {
+            memset(f_archetype__instanceGet(Archetype, row, c),
+                   0,
+                   Archetype->columns[c].component->size);
+        }
+    } else {
+        row = Archetype->rowsNum++;
+
+        if(row / F_ARCHETYPE__CHUNK_ROWS == Archetype->chunksNum) {
+            if(Archetype->chunksNum == Archetype->chunksCapacity) {
+                Archetype->chunks = arrayGrow(Archetype->chunks,
+                                              &Archetype->chunksCapacity,
+                                              sizeof(uint8_t*));
+            }
+
+            // Zeroed once here, fresh rows need no memset
+            Archetype->chunks[Archetype->chunksNum++] =
+                f_mem_mallocz(Archetype->chunkSize);
+        }
+    }
+
+    return row;
+}
+
+void f_archetype__rowFree(FArchetype* Archetype, unsigned Row)
+{
+    if(Archetype->freeRowsNum == Archetype->freeRowsCapacity) {
+        Archetype->freeRows = arrayGrow(Archetype->freeRows,
+                                        &Archetype->freeRowsCapacity,
+                                        sizeof(unsigned));
+    }
+
+    Archetype->freeRows[Archetype->freeRowsNum++] = Row;
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef F_INC_ECS_ARCHETYPE_V_H
+#define F_INC_ECS_ARCHETYPE_V_H
+
+#include "f_archetype.p.h"
+
+typedef struct FArchetype FArchetype;
+
+#include "../data/f_array.v.h"
+#include "../data/f_bitfield.v.h"
+#include "../data/f_list.v.h"
+#include "../ecs/f_component.v.h"
+
+#if F_CONFIG_TRAIT_LOW_MEM
+    #define F_ARCHETYPE__CHUNK_ROWS 8
+#else
+    #define F_ARCHETYPE__CHUNK_ROWS 64
+#endif
+
+typedef struct {
+    const FComponent* component; // component stored in this column
+    size_t offset; // where the column starts in each chunk
+    size_t stride; // aligned size of each component instance
+} FArchetypeColumn;
+
+struct FArchetype {
+    FBitfield componentBits; // the components every entity here has
+    FArchetype** next; // [f_component__num] cached archetype + one component
+    FArray* systemsActive; // FArray<FSystem*> matching active-only systems
+    FArray* systemsRest; // FArray<FSystem*> matching other systems
+    FArchetypeColumn* columns; // [columnsNum] one packed array per component
+    unsigned columnsNum; // number of components in this archetype
+    size_t chunkSize; // bytes per chunk, all columns included
+    uint8_t** chunks; // [chunksCapacity] fixed-size, never moved once made
+    unsigned chunksNum; // chunks allocated so far
+    unsigned chunksCapacity; // capacity of chunks array
+    unsigned rowsNum; // rows handed out so far, including released ones
+    unsigned* freeRows; // [freeRowsCapacity] stack of released rows
+    unsigned freeRowsNum; // number of rows on freeRows stack
+    unsigned freeRowsCapacity; // capacity of freeRows array
+};
+
+extern void f_archetype__init(void);
+extern void f_archetype__uninit(void);
+
+extern FArchetype* f_archetype__get(const FBitfield* ComponentBits);
+extern FArchetype* f_archetype__getNext(FArchetype* Archetype, const FComponent* Component);
+
+extern unsigned f_archetype__rowNew(FArchetype* Archetype);
+extern void f_archetype__rowFree(FArchetype* Archetype, unsigned Row);
+
+static inline FComponentInstance* f_archetype__instanceGet(const FArchetype* Archetype, unsigned Row, unsigned Column)
+{
+    const FArchetypeColumn* column = &Archetype->columns[Column];
+
+    return (FComponentInstance*)(void*)
+            (Archetype->chunks[Row / F_ARCHETYPE__CHUNK_ROWS]
+                + column->offset
+                + (Row % F_ARCHETYPE__CHUNK_ROWS) * column->stride);
+}
+
+#endif // F_INC_ECS_ARCHETYPE_V_H
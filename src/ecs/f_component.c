@@ -22,16 +22,12 @@ FComponent* const* f_component__array; // [f_component__num]
 unsigned f_component__num;
 FHash* f_component__index; // FHash<const char*, FComponent*>
 
-static FPool** g_pools;
-
 void f_component__init(FComponent* const* Components, size_t ComponentsNum)
 {
     f_component__array = Components;
     f_component__num = (unsigned)ComponentsNum;
     f_component__index = f_hash_newStr(256, false);
 
-    g_pools = f_mem_malloc(ComponentsNum * sizeof(FPool*));
-
     for(unsigned c = f_component__num; c--; ) {
         FComponent* com = f_component__array[c];
 
@@ -40,18 +36,11 @@ void f_component__init(FComponent* const* Components, size_t ComponentsNum)
         com->bitId = c;
 
         f_hash_add(f_component__index, com->stringId, com);
-
-        g_pools[c] = f_pool_new(com->size);
     }
 }
 
 void f_component__uninit(void)
 {
-    for(unsigned c = f_component__num; c--; ) {
-        f_pool_free(g_pools[c]);
-    }
-
-    f_mem_free(g_pools);
     f_hash_free(f_component__index);
 }
 
@@ -68,7 +57,7 @@ const void* f_component_dataGet(const void* ComponentBuffer)
     #if F_CONFIG_DEBUG
         if(instance->entity->templ == NULL) {
             F_FATAL("f_component_dataGet(%s.%s): No template",
-                    instance->entity->id,
+                    f_entity_idGet(instance->entity),
                     instance->component->stringId);
         }
     #endif
@@ -109,18 +98,14 @@ void f_component__dataFree(const FComponent* Component, void* Buffer)
     f_mem_free(Buffer);
 }
 
-FComponentInstance* f_component__instanceNew(const FComponent* Component, FEntity* Entity, const void* Data)
+void f_component__instanceInit(FComponentInstance* Instance, const FComponent* Component, FEntity* Entity, const void* Data)
 {
-    FComponentInstance* c = f_pool_alloc(g_pools[Component->bitId]);
-
-    c->component = Component;
-    c->entity = Entity;
+    Instance->component = Component;
+    Instance->entity = Entity;
 
     if(Component->init) {
-        Component->init(c->buffer, Data);
+        Component->init(Instance->buffer, Data);
     }
-
-    return c;
 }
 
 void f_component__instanceFree(FComponentInstance* Instance)
@@ -132,6 +117,4 @@ void f_component__instanceFree(FComponentInstance* Instance)
     if(Instance->component->free) {
         Instance->component->free(Instance->buffer);
     }
-
-    f_pool_release(Instance);
 }
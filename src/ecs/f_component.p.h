@@ -31,12 +31,17 @@ typedef void FCallComponentDataFree(void* Data);
 typedef void FCallComponentInstanceInit(void* Self, const void* Data);
 typedef void FCallComponentInstanceFree(void* Self);
 
+typedef size_t FCallComponentInstanceSerialize(const void* Self, void* Buffer);
+typedef void FCallComponentInstanceDeserialize(void* Self, const void* Buffer, size_t Size);
+
 struct FComponent {
     unsigned size; // total size of FComponentInstance + user data that follows
     unsigned dataSize; // size of template data buffer
     const char* stringId; // unique string ID
     FCallComponentInstanceInit* init; // sets component buffer default values
     FCallComponentInstanceFree* free; // does not free the actual comp buffer
+    FCallComponentInstanceSerialize* serialize; // returns size if Buffer NULL
+    FCallComponentInstanceDeserialize* deserialize; // instead of init
     FCallComponentDataInit* dataInit; // init template buffer with FBlock
     FCallComponentDataFree* dataFree; // does not free the template buffer
     unsigned bitId; // unique number ID
@@ -53,6 +58,19 @@ struct FComponent {
         .stringId = F_STRINGIFY(Name),                                                            \
     }
 
+#define F_COMPONENT_SERIAL(Name, DataSize, DataInit, DataFree, InstanceSize, InstanceInit, InstanceFree, InstanceSerialize, InstanceDeserialize) \
+    FComponent Name = {                                                                           \
+        .size = (unsigned)InstanceSize,                                                           \
+        .init = (FCallComponentInstanceInit*)InstanceInit,                                        \
+        .free = (FCallComponentInstanceFree*)InstanceFree,                                        \
+        .serialize = (FCallComponentInstanceSerialize*)InstanceSerialize,                         \
+        .deserialize = (FCallComponentInstanceDeserialize*)InstanceDeserialize,                   \
+        .dataSize = (unsigned)DataSize,                                                           \
+        .dataInit = (FCallComponentDataInit*)DataInit,                                            \
+        .dataFree = (FCallComponentDataFree*)DataFree,                                            \
+        .stringId = F_STRINGIFY(Name),                                                            \
+    }
+
 extern const void* f_component_dataGet(const void* ComponentBuffer);
 extern FEntity* f_component_entityGet(const void* ComponentBuffer);
 
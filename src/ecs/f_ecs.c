@@ -28,6 +28,7 @@ static void f_ecs__uninit(void)
     f_entity__uninit();
     f_template__uninit();
     f_system__uninit();
+    f_archetype__uninit();
     f_component__uninit();
 }
 
@@ -40,6 +41,7 @@ const FPack f_pack__ecs = {
 void f_ecs__set(FComponent* const* Components, size_t ComponentsNum, FSystem* const* Systems, size_t SystemsNum)
 {
     f_component__init(Components, ComponentsNum);
+    f_archetype__init();
     f_system__init(Systems, SystemsNum);
     f_template__init();
     f_entity__init();
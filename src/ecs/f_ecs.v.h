@@ -20,6 +20,7 @@
 
 #include "f_ecs.p.h"
 
+#include "../ecs/f_archetype.v.h"
 #include "../ecs/f_component.v.h"
 #include "../ecs/f_system.v.h"
 #include "../general/f_init.v.h"
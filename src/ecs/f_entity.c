@@ -18,6 +18,14 @@
 #include "f_entity.v.h"
 #include <faur.v.h>
 
+#define F__HANDLE_GEN_MAX (UINT32_MAX >> F_ENTITY__HANDLE_INDEX_BITS)
+
+typedef struct {
+    FEntity* entity; // NULL if this slot is free
+    unsigned generation; // bumped each time the slot is released, never 0
+    unsigned nextFree; // next free slot index if this one is free
+} FEntitySlot;
+
 typedef enum {
     F_LIST__INVALID = -1,
     F_LIST__DEFAULT, // no pending changes
@@ -32,17 +40,43 @@ static FPool* g_pool; // To allocate entities from
 static FList* g_lists[F_LIST__NUM]; // Each entity is in exactly one of these
 static unsigned g_activeNum; // Number of active entities this frame
 static unsigned g_activeNumPermanent; // Number of always-active entities
+static FEntitySlot* g_slots; // [g_slotsCapacity] FEntityHandle index targets
+static unsigned g_slotsNum; // Slots handed out so far, including free ones
+static unsigned g_slotsCapacity; // Allocated length of g_slots
+static unsigned g_slotsFree; // Head of free slots chain, or UINT_MAX
 
 bool f_entity__ignoreRefDec; // Set to prevent using freed entities
 
+#if F_CONFIG_DEBUG
+static inline void parallelCheck(const char* Function)
+{
+    // These touch globals or other entities, threaded handlers would race
+    if(f_system__parallel) {
+        F__FATAL("%s: Called from a threaded system", Function);
+    }
+}
+#endif
+
+static inline bool componentIsLoose(const FEntity* Entity, unsigned BitId)
+{
+    return Entity->componentsTable[BitId] != NULL
+            && (Entity->rowArchetype == NULL
+                || !f_bitfield_test(
+                        &Entity->rowArchetype->componentBits, BitId));
+}
+
 static FComponentInstance* componentAdd(FEntity* Entity, const FComponent* Component, const void* Data)
 {
-    FComponentInstance* c = f_component__instanceNew(Component, Entity, Data);
+    // The row's instances are already initialized and may be pointed to,
+    // so added components live outside it instead of moving the row
+    FComponentInstance* instance = f_mem_mallocz(Component->size);
 
-    Entity->componentsTable[Component->bitId] = c;
-    f_bitfield_set(Entity->componentBits, Component->bitId);
+    Entity->componentsTable[Component->bitId] = instance;
+    Entity->archetype = f_archetype__getNext(Entity->archetype, Component);
 
-    return c;
+    f_component__instanceInit(instance, Component, Entity, Data);
+
+    return instance;
 }
 
 static inline bool canDelete(const FEntity* Entity)
@@ -68,15 +102,84 @@ static inline void listMoveTo(FEntity* Entity, FEntityList List)
     listAddTo(Entity, List);
 }
 
+static FEntityHandle handleNew(FEntity* Entity)
+{
+    unsigned index = g_slotsFree;
+
+    if(index != UINT_MAX) {
+        g_slotsFree = g_slots[index].nextFree;
+    } else {
+        // Past this the index would spill into the generation bits
+        if(g_slotsNum > F_ENTITY__HANDLE_INDEX_MASK) {
+            F__FATAL("handleNew(%s): Too many entities",
+                     f_entity_idGet(Entity));
+        }
+
+        if(g_slotsNum == g_slotsCapacity) {
+            unsigned capacity = g_slotsCapacity ? g_slotsCapacity * 2 : 64;
+            FEntitySlot* slots = f_mem_malloc(capacity * sizeof(FEntitySlot));
+
+            if(g_slots) {
+                memcpy(slots, g_slots, g_slotsNum * sizeof(FEntitySlot));
+                f_mem_free(g_slots);
+            }
+
+            g_slots = slots;
+            g_slotsCapacity = capacity;
+        }
+
+        index = g_slotsNum++;
+        g_slots[index].generation = 1;
+    }
+
+    g_slots[index].entity = Entity;
+
+    return (FEntityHandle)(g_slots[index].generation << F_ENTITY__HANDLE_INDEX_BITS)
+            | index;
+}
+
+static void handleFree(FEntityHandle Handle)
+{
+    FEntitySlot* slot = &g_slots[Handle & F_ENTITY__HANDLE_INDEX_MASK];
+
+    slot->entity = NULL;
+    slot->generation = slot->generation % F__HANDLE_GEN_MAX + 1;
+    slot->nextFree = g_slotsFree;
+
+    g_slotsFree = Handle & F_ENTITY__HANDLE_INDEX_MASK;
+}
+
+static void handlesRebuild(void)
+{
+    g_slotsFree = UINT_MAX;
+
+    for(unsigned i = g_slotsNum; i--; ) {
+        if(g_slots[i].entity == NULL) {
+            g_slots[i].nextFree = g_slotsFree;
+            g_slotsFree = i;
+        }
+    }
+}
+
+static void systemsRemove(FEntity* Entity, const FArray* Systems)
+{
+    F_ARRAY_ITERATE(Systems, FSystem*, system) {
+        f_system__entityRemove(system, Entity);
+    }
+}
+
 void f_entity__init(void)
 {
     g_pool = f_pool_new(
                 sizeof(FEntity)
-                    + sizeof(FComponentInstance*) * (f_component__num - 1));
+                    + sizeof(FComponentInstance*) * (f_component__num - 1)
+                    + sizeof(unsigned) * f_system__num);
 
     for(int i = F_LIST__NUM; i--; ) {
         g_lists[i] = f_list_new();
     }
+
+    g_slotsFree = UINT_MAX;
 }
 
 void f_entity__uninit(void)
@@ -87,6 +190,12 @@ void f_entity__uninit(void)
         f_list_freeEx(g_lists[i], (FCallFree*)f_entity__free);
     }
 
+    f_mem_free(g_slots);
+
+    g_slots = NULL;
+    g_slotsNum = 0;
+    g_slotsCapacity = 0;
+
     f_pool_free(g_pool);
 }
 
@@ -102,16 +211,9 @@ void f_entity__tick(void)
 
     // Check what systems the new entities match
     F_LIST_ITERATE(g_lists[F_LIST__NEW], FEntity*, e) {
-        for(unsigned s = f_system__num; s--; ) {
-            FSystem* system = f_system__array[s];
-
-            if(f_bitfield_testMask(e->componentBits, system->componentBits)) {
-                if(system->onlyActiveEntities) {
-                    f_list_addLast(e->matchingSystemsActive, system);
-                } else {
-                    f_list_addLast(e->matchingSystemsRest, system);
-                }
-            }
+        if(e->archetype) {
+            e->matchingSystemsActive = e->archetype->systemsActive;
+            e->matchingSystemsRest = e->archetype->systemsRest;
         }
 
         listAddTo(e, F_LIST__RESTORE);
@@ -120,24 +222,23 @@ void f_entity__tick(void)
     // Add entities to the systems they match
     F_LIST_ITERATE(g_lists[F_LIST__RESTORE], FEntity*, e) {
         #if F_CONFIG_DEBUG
-            if(f_list_sizeIsEmpty(e->matchingSystemsActive)
-                && f_list_sizeIsEmpty(e->matchingSystemsRest)) {
+            if(f_array_sizeIsEmpty(e->matchingSystemsActive)
+                && f_array_sizeIsEmpty(e->matchingSystemsRest)) {
 
                 f_out__warning(
-                    "Entity %s was not matched to any systems", e->id);
+                    "Entity %s was not matched to any systems",
+                    f_entity_idGet(e));
             }
         #endif
 
         if(!F_FLAGS_TEST_ANY(e->flags, F_ENTITY__ACTIVE_REMOVED)) {
-            F_LIST_ITERATE(e->matchingSystemsActive, FSystem*, system) {
-                f_list_addLast(
-                    e->systemNodesActive, f_system__entityAdd(system, e));
+            F_ARRAY_ITERATE(e->matchingSystemsActive, FSystem*, system) {
+                f_system__entityAdd(system, e);
             }
         }
 
-        F_LIST_ITERATE(e->matchingSystemsRest, FSystem*, system) {
-            f_list_addLast(
-                e->systemNodesEither, f_system__entityAdd(system, e));
+        F_ARRAY_ITERATE(e->matchingSystemsRest, FSystem*, system) {
+            f_system__entityAdd(system, e);
         }
 
         listAddTo(e, F_LIST__DEFAULT);
@@ -153,12 +254,12 @@ void f_entity__flushFromSystems(void)
     F_LIST_ITERATE(g_lists[F_LIST__FLUSH], FEntity*, e) {
         #if F_CONFIG_DEBUG
             if(F_FLAGS_TEST_ANY(e->flags, F_ENTITY__DEBUG)) {
-                f_out__info("%s removed from all systems", e->id);
+                f_out__info("%s removed from all systems", f_entity_idGet(e));
             }
         #endif
 
-        f_list_clearEx(e->systemNodesActive, (FCallFree*)f_list_removeNode);
-        f_list_clearEx(e->systemNodesEither, (FCallFree*)f_list_removeNode);
+        systemsRemove(e, e->matchingSystemsActive);
+        systemsRemove(e, e->matchingSystemsRest);
 
         listAddTo(e, canDelete(e) ? F_LIST__FREE : F_LIST__DEFAULT);
     }
@@ -170,12 +271,13 @@ void f_entity__flushFromSystemsActive(FEntity* Entity)
 {
     #if F_CONFIG_DEBUG
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
-            f_out__info("%s removed from active-only systems", Entity->id);
+            f_out__info("%s removed from active-only systems",
+                        f_entity_idGet(Entity));
         }
     #endif
 
     F_FLAGS_SET(Entity->flags, F_ENTITY__ACTIVE_REMOVED);
-    f_list_clearEx(Entity->systemNodesActive, (FCallFree*)f_list_removeNode);
+    systemsRemove(Entity, Entity->matchingSystemsActive);
 
     if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__REMOVE_INACTIVE)) {
         f_entity_removedSet(Entity);
@@ -202,47 +304,201 @@ unsigned f_entity__numGetActive(void)
     return g_activeNum + g_activeNumPermanent;
 }
 
-FEntity* f_entity_new(const char* Template, const void* Context)
+static FEntity* entityNew(void)
 {
+    #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_new");
+    #endif
+
     FEntity* e = f_pool_alloc(g_pool);
 
     listAddTo(e, F_LIST__NEW);
 
     e->id = "FEntity";
-    e->matchingSystemsActive = f_list_new();
-    e->matchingSystemsRest = f_list_new();
-    e->systemNodesActive = f_list_new();
-    e->systemNodesEither = f_list_new();
-    e->componentBits = f_bitfield_new(f_component__num);
+    e->handle = handleNew(e);
+    e->matchingSystemsActive = &f__array_empty;
+    e->matchingSystemsRest = &f__array_empty;
+    e->systemSlots = (unsigned*)(e->componentsTable + f_component__num);
+
+    for(unsigned s = f_system__num; s--; ) {
+        e->systemSlots[s] = F_SYSTEM__SLOT_NONE;
+    }
+
     e->lastActive = f_fps_ticksGet() - 1;
 
     if(f__collection) {
         e->collectionNode = f_list_addLast(f__collection, e);
     }
 
-    if(Template) {
-        char id[64];
-        const FTemplate* t = f_template__get(Template);
+    return e;
+}
 
-        if(!f_str_fmt(id, sizeof(id), false, "%s#%08X", Template, t->iNumber)) {
-            id[0] = '\0';
+static void entityTemplateInit(FEntity* Entity, const FTemplate* Template, const void* Context)
+{
+    FArchetype* a = Template->archetype;
+
+    Entity->templ = Template;
+
+    if(a) {
+        Entity->archetype = a;
+        Entity->rowArchetype = a;
+        Entity->archetypeRow = f_archetype__rowNew(a);
+
+        for(unsigned c = a->columnsNum; c--; ) {
+            Entity->componentsTable[a->columns[c].component->bitId] =
+                f_archetype__instanceGet(a, Entity->archetypeRow, c);
         }
+    }
 
-        e->id = f_str_dup(id);
-        e->templ = t;
+    F_ARRAY_ITERATE(Template->componentsAll, const FComponent*, c) {
+        f_component__instanceInit(Entity->componentsTable[c->bitId],
+                                  c,
+                                  Entity,
+                                  Template->data[c->bitId]);
+    }
 
-        F_FLAGS_SET(e->flags, F_ENTITY__ALLOC_STRING_ID);
+    f_template__initRun(Template, Entity, Context);
+}
+
+static FEntity* entityNewFrom(const FTemplate* Template, unsigned Number, const void* Context)
+{
+    FEntity* e = entityNew();
+
+    if(Template) {
+        // The ID string is only made if f_entity_idGet asks for it
+        e->id = NULL;
+        e->templNumber = Number;
 
-        F_LIST_ITERATE(t->componentsAll, const FComponent*, c) {
-            componentAdd(e, c, t->data[c->bitId]);
+        entityTemplateInit(e, Template, Context);
+    }
+
+    return e;
+}
+
+FEntity* f_entity_new(const char* Template, const void* Context)
+{
+    const FTemplate* t = Template ? f_template__get(Template) : NULL;
+
+    return entityNewFrom(t, t ? t->iNumber : 0, Context);
+}
+
+FEntity* f_entity_newId(const FStrId* Template, const void* Context)
+{
+    const FTemplate* t = f_template__getStrId(Template);
+
+    return entityNewFrom(t, t->iNumber, Context);
+}
+
+// Looks the template up once; entities are still made one at a time
+void f_entity_newBatch(const char* Template, unsigned Count, const void* const* Contexts, FEntity** Entities)
+{
+    const FTemplate* t = f_template__getBatch(Template, Count);
+    unsigned number = t->iNumber - Count;
+
+    for(unsigned i = 0; i < Count; i++) {
+        FEntity* e = entityNewFrom(t, ++number, Contexts ? Contexts[i] : NULL);
+
+        if(Entities) {
+            Entities[i] = e;
         }
+    }
+}
+
+unsigned f_entity__slotsNumGet(void)
+{
+    return g_slotsNum;
+}
+
+unsigned f_entity__slotGenerationGet(unsigned Index)
+{
+    return g_slots[Index].generation;
+}
+
+FEntity* f_entity__slotEntityGet(unsigned Index)
+{
+    return g_slots[Index].entity;
+}
+
+void f_entity__restoreStart(const uint32_t* Generations, unsigned SlotsNum)
+{
+    f_entity__ignoreRefDec = true;
+
+    for(int i = F_LIST__NUM; i--; ) {
+        f_list_clearEx(g_lists[i], (FCallFree*)f_entity__free);
+    }
+
+    f_entity__ignoreRefDec = false;
+
+    g_activeNum = 0;
+
+    if(SlotsNum > g_slotsCapacity) {
+        f_mem_free(g_slots);
+
+        g_slots = f_mem_malloc(SlotsNum * sizeof(FEntitySlot));
+        g_slotsCapacity = SlotsNum;
+    }
+
+    for(unsigned i = SlotsNum; i--; ) {
+        g_slots[i].entity = NULL;
+        g_slots[i].generation = Generations[i];
+    }
+
+    g_slotsNum = SlotsNum;
+}
+
+FEntity* f_entity__restoreNew(FEntityHandle Handle, FArchetype* Archetype, int MuteCount)
+{
+    FEntity* e = f_pool_alloc(g_pool);
+
+    e->id = "FEntity";
+    e->handle = Handle;
+    e->matchingSystemsActive = &f__array_empty;
+    e->matchingSystemsRest = &f__array_empty;
+    e->systemSlots = (unsigned*)(e->componentsTable + f_component__num);
+    e->muteCount = MuteCount;
+
+    for(unsigned s = f_system__num; s--; ) {
+        e->systemSlots[s] = F_SYSTEM__SLOT_NONE;
+    }
+
+    g_slots[Handle & F_ENTITY__HANDLE_INDEX_MASK].entity = e;
+
+    if(f__collection) {
+        e->collectionNode = f_list_addLast(f__collection, e);
+    }
 
-        f_template__initRun(t, e, Context);
+    if(Archetype) {
+        e->archetype = Archetype;
+        e->rowArchetype = Archetype;
+        e->archetypeRow = f_archetype__rowNew(Archetype);
+
+        for(unsigned c = Archetype->columnsNum; c--; ) {
+            e->componentsTable[Archetype->columns[c].component->bitId] =
+                f_archetype__instanceGet(Archetype, e->archetypeRow, c);
+        }
     }
 
+    // Muted entities wait to be matched to systems until they are unmuted
+    listAddTo(e, MuteCount > 0 ? F_LIST__DEFAULT : F_LIST__NEW);
+
     return e;
 }
 
+void f_entity__restoreEnd(void)
+{
+    handlesRebuild();
+
+    g_activeNumPermanent = 0;
+
+    for(unsigned i = g_slotsNum; i--; ) {
+        FEntity* e = g_slots[i].entity;
+
+        if(e && F_FLAGS_TEST_ANY(e->flags, F_ENTITY__ACTIVE_PERMANENT)) {
+            g_activeNumPermanent++;
+        }
+    }
+}
+
 void f_entity__free(FEntity* Entity)
 {
     if(Entity == NULL) {
@@ -251,7 +507,7 @@ void f_entity__free(FEntity* Entity)
 
     #if F_CONFIG_DEBUG
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
-            f_out__info("f_entity__free(%s)", Entity->id);
+            f_out__info("f_entity__free(%s)", f_entity_idGet(Entity));
         }
     #endif
 
@@ -259,20 +515,22 @@ void f_entity__free(FEntity* Entity)
         f_list_removeNode(Entity->collectionNode);
     }
 
-    f_list_free(Entity->matchingSystemsActive);
-    f_list_free(Entity->matchingSystemsRest);
-    f_list_freeEx(Entity->systemNodesActive, (FCallFree*)f_list_removeNode);
-    f_list_freeEx(Entity->systemNodesEither, (FCallFree*)f_list_removeNode);
+    systemsRemove(Entity, Entity->matchingSystemsActive);
+    systemsRemove(Entity, Entity->matchingSystemsRest);
 
     for(unsigned c = f_component__num; c--; ) {
         f_component__instanceFree(Entity->componentsTable[c]);
+
+        if(componentIsLoose(Entity, c)) {
+            f_mem_free(Entity->componentsTable[c]);
+        }
     }
 
-    if(Entity->parent) {
-        f_entity_refDec(Entity->parent);
+    if(Entity->rowArchetype) {
+        f_archetype__rowFree(Entity->rowArchetype, Entity->archetypeRow);
     }
 
-    f_bitfield_free(Entity->componentBits);
+    handleFree(Entity->handle);
 
     if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__ALLOC_STRING_ID)) {
         f_mem_free(Entity->id);
@@ -298,6 +556,10 @@ void f_entity__freeEx(FEntity* Entity)
 
 void f_entity_debugSet(FEntity* Entity, bool DebugOn)
 {
+    #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_debugSet");
+    #endif
+
     if(DebugOn) {
         F_FLAGS_SET(Entity->flags, F_ENTITY__DEBUG);
     } else {
@@ -305,18 +567,67 @@ void f_entity_debugSet(FEntity* Entity, bool DebugOn)
     }
 
     #if F_CONFIG_DEBUG
-        f_out__info("f_entity_debugSet(%s, %d)", Entity->id, DebugOn);
+        f_out__info("f_entity_debugSet(%s, %d)",
+                    f_entity_idGet(Entity),
+                    DebugOn);
     #endif
 }
 
 const char* f_entity_idGet(const FEntity* Entity)
 {
+    if(Entity->id == NULL) {
+        #if F_CONFIG_DEBUG
+            parallelCheck("f_entity_idGet");
+        #endif
+
+        char id[64];
+        FEntity* e = (FEntity*)Entity;
+
+        if(!f_str_fmt(id,
+                      sizeof(id),
+                      false,
+                      "%s#%08X",
+                      e->templ->stringId,
+                      e->templNumber)) {
+
+            id[0] = '\0';
+        }
+
+        e->id = f_str_dup(id);
+
+        F_FLAGS_SET(e->flags, F_ENTITY__ALLOC_STRING_ID);
+    }
+
     return Entity->id;
 }
 
+FEntityHandle f_entity_handleGet(const FEntity* Entity)
+{
+    return Entity->handle;
+}
+
+FEntity* f_entity_handleResolve(FEntityHandle Handle)
+{
+    unsigned index = Handle & F_ENTITY__HANDLE_INDEX_MASK;
+
+    if(Handle == F_ENTITY_HANDLE_NULL || index >= g_slotsNum) {
+        return NULL;
+    }
+
+    FEntity* e = g_slots[index].entity;
+
+    if(e == NULL || e->handle != Handle
+        || F_FLAGS_TEST_ANY(e->flags, F_ENTITY__REMOVED)) {
+
+        return NULL;
+    }
+
+    return e;
+}
+
 FEntity* f_entity_parentGet(const FEntity* Entity)
 {
-    return Entity->parent;
+    return f_entity_handleResolve(Entity->parent);
 }
 
 void f_entity_parentSet(FEntity* Entity, FEntity* Parent)
@@ -324,8 +635,8 @@ void f_entity_parentSet(FEntity* Entity, FEntity* Parent)
     #if F_CONFIG_DEBUG
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
             f_out__info("f_entity_parentSet(%s, %s)",
-                        Entity->id,
-                        Parent ? Parent->id : "NULL");
+                        f_entity_idGet(Entity),
+                        Parent ? f_entity_idGet(Parent) : "NULL");
         }
 
         if(Parent
@@ -335,25 +646,20 @@ void f_entity_parentSet(FEntity* Entity, FEntity* Parent)
                         != f_list__nodeGetList(Entity->collectionNode)))) {
 
             F__FATAL("f_entity_parentSet(%s, %s): Different collections",
-                     Entity->id,
-                     Parent->id);
+                     f_entity_idGet(Entity),
+                     f_entity_idGet(Parent));
         }
     #endif
 
-    if(Entity->parent) {
-        f_entity_refDec(Entity->parent);
-    }
-
-    Entity->parent = Parent;
-
-    if(Parent) {
-        f_entity_refInc(Parent);
-    }
+    Entity->parent = Parent ? Parent->handle : F_ENTITY_HANDLE_NULL;
 }
 
 bool f_entity_parentHas(const FEntity* Child, const FEntity* PotentialParent)
 {
-    for(FEntity* p = Child->parent; p != NULL; p = p->parent) {
+    for(FEntity* p = f_entity_parentGet(Child);
+        p != NULL;
+        p = f_entity_parentGet(p)) {
+
         if(p == PotentialParent) {
             return true;
         }
@@ -365,17 +671,21 @@ bool f_entity_parentHas(const FEntity* Child, const FEntity* PotentialParent)
 void f_entity_refInc(FEntity* Entity)
 {
     #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_refInc");
+
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__REMOVED)) {
-            F__FATAL("f_entity_refInc(%s): Entity is removed", Entity->id);
+            F__FATAL("f_entity_refInc(%s): Entity is removed",
+                     f_entity_idGet(Entity));
         }
 
         if(Entity->references == INT_MAX) {
-            F__FATAL("f_entity_refInc(%s): Count too high", Entity->id);
+            F__FATAL("f_entity_refInc(%s): Count too high",
+                     f_entity_idGet(Entity));
         }
 
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
             f_out__info("f_entity_refInc(%s) %d->%d",
-                        Entity->id,
+                        f_entity_idGet(Entity),
                         Entity->references,
                         Entity->references + 1);
         }
@@ -394,13 +704,16 @@ void f_entity_refDec(FEntity* Entity)
     }
 
     #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_refDec");
+
         if(Entity->references == 0) {
-            F__FATAL("f_entity_refDec(%s): Count too low", Entity->id);
+            F__FATAL("f_entity_refDec(%s): Count too low",
+                     f_entity_idGet(Entity));
         }
 
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
             f_out__info("f_entity_refDec(%s) %d->%d",
-                        Entity->id,
+                        f_entity_idGet(Entity),
                         Entity->references,
                         Entity->references - 1);
         }
@@ -420,10 +733,15 @@ bool f_entity_removedGet(const FEntity* Entity)
 
 void f_entity_removedSet(FEntity* Entity)
 {
+    #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_removedSet");
+    #endif
+
     if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__REMOVED)) {
         #if F_CONFIG_DEBUG
             f_out__warning(
-                "f_entity_removedSet(%s): Entity is removed", Entity->id);
+                "f_entity_removedSet(%s): Entity is removed",
+                f_entity_idGet(Entity));
         #endif
 
         return;
@@ -431,7 +749,7 @@ void f_entity_removedSet(FEntity* Entity)
 
     #if F_CONFIG_DEBUG
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
-            f_out__info("f_entity_removedSet(%s)", Entity->id);
+            f_out__info("f_entity_removedSet(%s)", f_entity_idGet(Entity));
         }
     #endif
 
@@ -447,6 +765,10 @@ bool f_entity_activeGet(const FEntity* Entity)
 
 void f_entity_activeSet(FEntity* Entity)
 {
+    #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_activeSet");
+    #endif
+
     if(Entity->muteCount > 0
         || F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__REMOVED)) {
 
@@ -455,7 +777,7 @@ void f_entity_activeSet(FEntity* Entity)
 
     #if F_CONFIG_DEBUG
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
-            f_out__info("f_entity_activeSet(%s)", Entity->id);
+            f_out__info("f_entity_activeSet(%s)", f_entity_idGet(Entity));
         }
     #endif
 
@@ -469,9 +791,8 @@ void f_entity_activeSet(FEntity* Entity)
         F_FLAGS_CLEAR(Entity->flags, F_ENTITY__ACTIVE_REMOVED);
 
         // Add entity back to active-only systems
-        F_LIST_ITERATE(Entity->matchingSystemsActive, FSystem*, system) {
-            f_list_addLast(
-                Entity->systemNodesActive, f_system__entityAdd(system, Entity));
+        F_ARRAY_ITERATE(Entity->matchingSystemsActive, FSystem*, system) {
+            f_system__entityAdd(system, Entity);
         }
     }
 }
@@ -480,7 +801,7 @@ void f_entity_activeSetRemove(FEntity* Entity)
 {
     #if F_CONFIG_DEBUG
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
-            f_out__info("f_entity_activeSetRemove(%s)", Entity->id);
+            f_out__info("f_entity_activeSetRemove(%s)", f_entity_idGet(Entity));
         }
     #endif
 
@@ -490,8 +811,11 @@ void f_entity_activeSetRemove(FEntity* Entity)
 void f_entity_activeSetPermanent(FEntity* Entity)
 {
     #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_activeSetPermanent");
+
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
-            f_out__info("f_entity_activeSetPermanent(%s)", Entity->id);
+            f_out__info("f_entity_activeSetPermanent(%s)",
+                        f_entity_idGet(Entity));
         }
     #endif
 
@@ -503,21 +827,23 @@ void f_entity_activeSetPermanent(FEntity* Entity)
 void* f_entity_componentAdd(FEntity* Entity, const FComponent* Component)
 {
     #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_componentAdd");
+
         if(!listIsIn(Entity, F_LIST__NEW)) {
             F__FATAL("f_entity_componentAdd(%s, %s): Too late",
-                     Entity->id,
+                     f_entity_idGet(Entity),
                      Component->stringId);
         }
 
         if(Entity->componentsTable[Component->bitId] != NULL) {
             F__FATAL("f_entity_componentAdd(%s, %s): Already added",
-                     Entity->id,
+                     f_entity_idGet(Entity),
                      Component->stringId);
         }
 
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
             f_out__info("f_entity_componentAdd(%s, %s)",
-                        Entity->id,
+                        f_entity_idGet(Entity),
                         Component->stringId);
         }
     #endif
@@ -544,7 +870,7 @@ void* f_entity_componentReq(const FEntity* Entity, const FComponent* Component)
     #if F_CONFIG_DEBUG
         if(instance == NULL) {
             F__FATAL("f_entity_componentReq(%s, %s): Missing component",
-                     Entity->id,
+                     f_entity_idGet(Entity),
                      Component->stringId);
         }
     #endif
@@ -559,10 +885,15 @@ bool f_entity_muteGet(const FEntity* Entity)
 
 void f_entity_muteInc(FEntity* Entity)
 {
+    #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_muteInc");
+    #endif
+
     if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__REMOVED)) {
         #if F_CONFIG_DEBUG
             f_out__warning(
-                "f_entity_muteInc(%s): Entity is removed", Entity->id);
+                "f_entity_muteInc(%s): Entity is removed",
+                f_entity_idGet(Entity));
         #endif
 
         return;
@@ -570,12 +901,13 @@ void f_entity_muteInc(FEntity* Entity)
 
     #if F_CONFIG_DEBUG
         if(Entity->muteCount == INT_MAX) {
-            F__FATAL("f_entity_muteInc(%s): Count too high", Entity->id);
+            F__FATAL("f_entity_muteInc(%s): Count too high",
+                     f_entity_idGet(Entity));
         }
 
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
             f_out__info("f_entity_muteInc(%s) %d->%d",
-                        Entity->id,
+                        f_entity_idGet(Entity),
                         Entity->muteCount,
                         Entity->muteCount + 1);
         }
@@ -588,10 +920,15 @@ void f_entity_muteInc(FEntity* Entity)
 
 void f_entity_muteDec(FEntity* Entity)
 {
+    #if F_CONFIG_DEBUG
+        parallelCheck("f_entity_muteDec");
+    #endif
+
     if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__REMOVED)) {
         #if F_CONFIG_DEBUG
             f_out__warning(
-                "f_entity_muteDec(%s): Entity is removed", Entity->id);
+                "f_entity_muteDec(%s): Entity is removed",
+                f_entity_idGet(Entity));
         #endif
 
         return;
@@ -599,20 +936,21 @@ void f_entity_muteDec(FEntity* Entity)
 
     #if F_CONFIG_DEBUG
         if(Entity->muteCount == 0) {
-            F__FATAL("f_entity_muteDec(%s): Count too low", Entity->id);
+            F__FATAL("f_entity_muteDec(%s): Count too low",
+                     f_entity_idGet(Entity));
         }
 
         if(F_FLAGS_TEST_ANY(Entity->flags, F_ENTITY__DEBUG)) {
             f_out__info("f_entity_muteDec(%s) %d->%d",
-                        Entity->id,
+                        f_entity_idGet(Entity),
                         Entity->muteCount,
                         Entity->muteCount - 1);
         }
     #endif
 
     if(--Entity->muteCount == 0) {
-        if(!f_list_sizeIsEmpty(Entity->matchingSystemsActive)
-            || !f_list_sizeIsEmpty(Entity->matchingSystemsRest)) {
+        if(!f_array_sizeIsEmpty(Entity->matchingSystemsActive)
+            || !f_array_sizeIsEmpty(Entity->matchingSystemsRest)) {
 
             if(listIsIn(Entity, F_LIST__FLUSH)) {
                 // Entity was muted and unmuted before it left systems
@@ -21,15 +21,24 @@
 #include "../general/f_system_includes.h"
 
 typedef struct FEntity FEntity;
+typedef uint32_t FEntityHandle;
+
+#define F_ENTITY_HANDLE_NULL 0
 
 #include "../ecs/f_component.p.h"
+#include "../strings/f_strid.p.h"
 
 extern FEntity* f_entity_new(const char* Template, const void* Context);
+extern FEntity* f_entity_newId(const FStrId* Template, const void* Context);
+extern void f_entity_newBatch(const char* Template, unsigned Count, const void* const* Contexts, FEntity** Entities);
 
 extern void f_entity_debugSet(FEntity* Entity, bool DebugOn);
 
 extern const char* f_entity_idGet(const FEntity* Entity);
 
+extern FEntityHandle f_entity_handleGet(const FEntity* Entity);
+extern FEntity* f_entity_handleResolve(FEntityHandle Handle);
+
 extern FEntity* f_entity_parentGet(const FEntity* Entity);
 extern void f_entity_parentSet(FEntity* Entity, FEntity* Parent);
 extern bool f_entity_parentHas(const FEntity* Child, const FEntity* PotentialParent);
@@ -20,7 +20,9 @@
 
 #include "f_entity.p.h"
 
+#include "../data/f_array.v.h"
 #include "../data/f_list.v.h"
+#include "../ecs/f_archetype.v.h"
 #include "../ecs/f_component.v.h"
 #include "../ecs/f_system.v.h"
 #include "../ecs/f_template.v.h"
@@ -32,22 +34,28 @@
 #define F_ENTITY__REMOVE_INACTIVE F_FLAGS_BIT(4) // mark for removal if kicked
 #define F_ENTITY__ALLOC_STRING_ID F_FLAGS_BIT(5) // free string ID if set
 
+#define F_ENTITY__HANDLE_INDEX_BITS 20
+#define F_ENTITY__HANDLE_INDEX_MASK ((1u << F_ENTITY__HANDLE_INDEX_BITS) - 1)
+
 struct FEntity {
-    char* id; // specified name for debugging
+    char* id; // specified name for debugging, or NULL until first asked for
     const FTemplate* templ; // template used to init this entity's components
-    FEntity* parent; // manually associated parent entity
+    unsigned templNumber; // instance number of templ, for the ID string
+    FEntityHandle handle; // index and generation in handles table
+    FEntityHandle parent; // manually associated parent entity
     FListNode* node; // list node in one of FEntityList
     FListNode* collectionNode; // FCollection list nod
-    FList* matchingSystemsActive; // FList<FSystem*>
-    FList* matchingSystemsRest; // FList<FSystem*>
-    FList* systemNodesActive; // FList<FListNode*> in active-only FSystem lists
-    FList* systemNodesEither; // FList<FListNode*> in rest FSystem lists
-    FBitfield* componentBits; // each component's bit is set
+    const FArray* matchingSystemsActive; // FArray<FSystem*> from archetype
+    const FArray* matchingSystemsRest; // FArray<FSystem*> from archetype
+    unsigned* systemSlots; // [f_system__num] index in FSystem arrays, or none
+    FArchetype* archetype; // this entity's components, or NULL if none
+    FArchetype* rowArchetype; // holds the components made with the entity
+    unsigned archetypeRow; // this entity's row in rowArchetype's arrays
     unsigned lastActive; // frame when f_entity_activeSet was last called
     int references; // if >0, then the entity lingers in the removed limbo list
     int muteCount; // if >0, then the entity isn't picked up by any systems
     unsigned flags; // various properties
-    FComponentInstance* componentsTable[1]; // [f_component__num] Buffer/NULL
+    FComponentInstance* componentsTable[1]; // [f_component__num] In row/heap/NULL
 };
 
 extern bool f_entity__ignoreRefDec;
@@ -65,4 +73,12 @@ extern void f_entity__freeEx(FEntity* Entity);
 
 extern void f_entity__flushFromSystemsActive(FEntity* Entity);
 
+extern unsigned f_entity__slotsNumGet(void);
+extern unsigned f_entity__slotGenerationGet(unsigned Index);
+extern FEntity* f_entity__slotEntityGet(unsigned Index);
+
+extern void f_entity__restoreStart(const uint32_t* Generations, unsigned SlotsNum);
+extern FEntity* f_entity__restoreNew(FEntityHandle Handle, FArchetype* Archetype, int MuteCount);
+extern void f_entity__restoreEnd(void);
+
 #endif // F_INC_ECS_ENTITY_V_H
@@ -0,0 +1,445 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "f_snapshot.v.h"
+#include <faur.v.h>
+
+#define F__MAGIC 0x46534e50 // "FSNP"
+#define F__ALIGN sizeof(FMaxMemAlignType)
+
+#define F__ID_DEFAULT 0 // "FEntity"
+#define F__ID_NUMBERED 1 // "Template#Number", made on demand
+
+typedef struct {
+    uint32_t magic;
+    uint32_t componentsNum; // must match f_component__num to restore
+    uint32_t slotsNum; // entity handle generations that follow
+    uint32_t entitiesNum; // entity records that follow the generations
+} FSnapshotHeader;
+
+typedef struct {
+    uint32_t handle;
+    uint32_t parent;
+    uint32_t templNumber;
+    uint32_t flags;
+    uint32_t lastActive;
+    int32_t muteCount;
+    uint32_t idMode;
+    uint32_t templateIdSize; // template name that follows, including '\0'
+    uint32_t componentsNum; // component records that follow the name
+} FSnapshotEntity;
+
+typedef struct {
+    uint32_t bitId;
+    uint32_t size; // bytes of component data that follow
+} FSnapshotComponent;
+
+struct FSnapshot {
+    size_t size; // total bytes, including this field
+    FMaxMemAlignType buffer[1]; // header and records
+};
+
+typedef struct {
+    uint8_t* buffer; // NULL when only measuring
+    size_t offset;
+} FSnapshotWriter;
+
+typedef struct {
+    const uint8_t* buffer;
+    size_t offset;
+    size_t size;
+} FSnapshotReader;
+
+static inline size_t alignSize(size_t Size)
+{
+    return (Size + F__ALIGN - 1) & ~(F__ALIGN - 1);
+}
+
+static void* bufferReserve(FSnapshotWriter* Writer, size_t Size)
+{
+    void* p = Writer->buffer ? Writer->buffer + Writer->offset : NULL;
+
+    Writer->offset += alignSize(Size);
+
+    return p;
+}
+
+static void bufferWrite(FSnapshotWriter* Writer, const void* Data, size_t Size)
+{
+    void* p = bufferReserve(Writer, Size);
+
+    if(p) {
+        memcpy(p, Data, Size);
+    }
+}
+
+static const void* bufferRead(FSnapshotReader* Reader, size_t Size)
+{
+    if(Reader->size - Reader->offset < Size) {
+        return NULL;
+    }
+
+    const void* p = Reader->buffer + Reader->offset;
+
+    Reader->offset += f_math_minz(alignSize(Size),
+                                  Reader->size - Reader->offset);
+
+    return p;
+}
+
+static size_t componentSize(const FComponent* Component)
+{
+    return Component->size
+            - (sizeof(FComponentInstance) - sizeof(FMaxMemAlignType));
+}
+
+static void writeEntity(FSnapshotWriter* Writer, const FEntity* Entity)
+{
+    FSnapshotEntity e;
+    const FArchetype* a = Entity->archetype;
+
+    memset(&e, 0, sizeof(e));
+
+    e.handle = Entity->handle;
+    e.parent = Entity->parent;
+    e.templNumber = Entity->templNumber;
+    e.flags = Entity->flags & ~(unsigned)F_ENTITY__ALLOC_STRING_ID;
+    e.lastActive = Entity->lastActive;
+    e.muteCount = Entity->muteCount;
+    e.componentsNum = a ? a->columnsNum : 0;
+
+    if(Entity->templ) {
+        e.idMode = F__ID_NUMBERED;
+        e.templateIdSize =
+            (uint32_t)strlen(Entity->templ->stringId) + 1;
+    } else {
+        e.idMode = F__ID_DEFAULT;
+    }
+
+    bufferWrite(Writer, &e, sizeof(e));
+
+    if(Entity->templ) {
+        bufferWrite(Writer, Entity->templ->stringId, e.templateIdSize);
+    }
+
+    for(unsigned c = 0; c < e.componentsNum; c++) {
+        const FComponent* com = a->columns[c].component;
+        const FComponentInstance* instance =
+            Entity->componentsTable[com->bitId];
+        FSnapshotComponent sc;
+
+        sc.bitId = com->bitId;
+
+        if(com->serialize) {
+            sc.size = (uint32_t)com->serialize(instance->buffer, NULL);
+        } else {
+            sc.size = (uint32_t)componentSize(com);
+        }
+
+        bufferWrite(Writer, &sc, sizeof(sc));
+
+        void* data = bufferReserve(Writer, sc.size);
+
+        if(data) {
+            if(com->serialize) {
+                com->serialize(instance->buffer, data);
+            } else {
+                memcpy(data, instance->buffer, sc.size);
+            }
+        }
+    }
+}
+
+static void writeWorld(FSnapshotWriter* Writer)
+{
+    FSnapshotHeader h;
+    unsigned slotsNum = f_entity__slotsNumGet();
+
+    h.magic = F__MAGIC;
+    h.componentsNum = f_component__num;
+    h.slotsNum = slotsNum;
+    h.entitiesNum = 0;
+
+    for(unsigned i = slotsNum; i--; ) {
+        const FEntity* e = f_entity__slotEntityGet(i);
+
+        // Removed entities are only waiting to be freed
+        if(e && !F_FLAGS_TEST_ANY(e->flags, F_ENTITY__REMOVED)) {
+            h.entitiesNum++;
+        }
+    }
+
+    bufferWrite(Writer, &h, sizeof(h));
+
+    uint32_t* generations = bufferReserve(Writer, slotsNum * sizeof(uint32_t));
+
+    if(generations) {
+        for(unsigned i = slotsNum; i--; ) {
+            generations[i] = f_entity__slotGenerationGet(i);
+        }
+    }
+
+    for(unsigned i = 0; i < slotsNum; i++) {
+        const FEntity* e = f_entity__slotEntityGet(i);
+
+        if(e && !F_FLAGS_TEST_ANY(e->flags, F_ENTITY__REMOVED)) {
+            writeEntity(Writer, e);
+        }
+    }
+}
+
+FSnapshot* f_snapshot_new(void)
+{
+    FSnapshotWriter writer = {NULL, 0};
+
+    writeWorld(&writer);
+
+    size_t size = offsetof(FSnapshot, buffer) + writer.offset;
+    FSnapshot* s = f_mem_malloc(size);
+
+    s->size = size;
+
+    writer.buffer = (uint8_t*)s->buffer;
+    writer.offset = 0;
+
+    writeWorld(&writer);
+
+    return s;
+}
+
+FSnapshot* f_snapshot_newFromBuffer(const void* Buffer, size_t Size)
+{
+    if(Size < offsetof(FSnapshot, buffer) + sizeof(FSnapshotHeader)) {
+        f_out__error("f_snapshot_newFromBuffer: Buffer too small");
+
+        return NULL;
+    }
+
+    FSnapshot* s = f_mem_malloc(Size);
+
+    memcpy(s, Buffer, Size);
+
+    if(s->size != Size) {
+        f_out__error("f_snapshot_newFromBuffer: Size mismatch");
+        f_mem_free(s);
+
+        return NULL;
+    }
+
+    return s;
+}
+
+void f_snapshot_free(FSnapshot* Snapshot)
+{
+    f_mem_free(Snapshot);
+}
+
+const void* f_snapshot_bufferGet(const FSnapshot* Snapshot)
+{
+    return Snapshot;
+}
+
+size_t f_snapshot_sizeGet(const FSnapshot* Snapshot)
+{
+    return Snapshot->size;
+}
+
+static bool readWorld(FSnapshotReader* Reader, bool Apply)
+{
+    FSnapshotHeader h;
+    const void* p = bufferRead(Reader, sizeof(h));
+
+    if(p == NULL) {
+        return false;
+    }
+
+    memcpy(&h, p, sizeof(h));
+
+    if(h.magic != F__MAGIC
+        || h.componentsNum != f_component__num
+        || h.slotsNum > F_ENTITY__HANDLE_INDEX_MASK + 1
+        || h.entitiesNum > h.slotsNum) {
+
+        return false;
+    }
+
+    const void* generations =
+        bufferRead(Reader, (size_t)h.slotsNum * sizeof(uint32_t));
+
+    if(generations == NULL) {
+        return false;
+    }
+
+    bool ok = false;
+    FBitfield* bits = NULL;
+    FBitfield* handles = NULL; // slots already used by an entity record
+
+    if(Apply) {
+        f_entity__restoreStart(generations, h.slotsNum);
+
+        bits = f_bitfield_new(f_component__num);
+    } else if(h.slotsNum > 0) {
+        handles = f_bitfield_new(h.slotsNum);
+    }
+
+    for(unsigned i = h.entitiesNum; i--; ) {
+        FSnapshotEntity se;
+
+        if((p = bufferRead(Reader, sizeof(se))) == NULL) {
+            goto done;
+        }
+
+        memcpy(&se, p, sizeof(se));
+
+        if(!Apply) {
+            unsigned slot = se.handle & F_ENTITY__HANDLE_INDEX_MASK;
+
+            // Each record needs its own slot from the generations table
+            if(slot >= h.slotsNum || f_bitfield_test(handles, slot)) {
+                goto done;
+            }
+
+            f_bitfield_set(handles, slot);
+        }
+
+        const FTemplate* t = NULL;
+
+        if(se.templateIdSize > 0) {
+            const char* id = bufferRead(Reader, se.templateIdSize);
+
+            if(se.idMode != F__ID_NUMBERED
+                || id == NULL || id[se.templateIdSize - 1] != '\0') {
+                goto done;
+            }
+
+            if((t = f_template__find(id)) == NULL) {
+                f_out__error("f_snapshot_restore: Unknown template '%s'", id);
+
+                goto done;
+            }
+        } else if(se.idMode != F__ID_DEFAULT) {
+            goto done;
+        }
+
+        // Components are read twice, first to find the entity's archetype
+        size_t componentsOffset = Reader->offset;
+
+        if(Apply) {
+            f_bitfield_reset(bits);
+        }
+
+        for(unsigned c = se.componentsNum; c--; ) {
+            FSnapshotComponent sc;
+
+            if((p = bufferRead(Reader, sizeof(sc))) == NULL) {
+                goto done;
+            }
+
+            memcpy(&sc, p, sizeof(sc));
+
+            if(sc.bitId >= f_component__num
+                || bufferRead(Reader, sc.size) == NULL) {
+
+                goto done;
+            }
+
+            const FComponent* com = f_component__array[sc.bitId];
+
+            if(com->deserialize == NULL && sc.size != componentSize(com)) {
+                f_out__error("f_snapshot_restore: %s size changed",
+                             com->stringId);
+
+                goto done;
+            }
+
+            if(Apply) {
+                f_bitfield_set(bits, sc.bitId);
+            }
+        }
+
+        if(!Apply) {
+            continue;
+        }
+
+        FEntity* e = f_entity__restoreNew(
+                        se.handle, f_archetype__get(bits), se.muteCount);
+
+        e->templ = t;
+        e->templNumber = se.templNumber;
+        e->parent = se.parent;
+        e->flags = se.flags;
+        e->lastActive = se.lastActive;
+
+        if(se.idMode == F__ID_NUMBERED) {
+            e->id = NULL;
+        }
+
+        Reader->offset = componentsOffset;
+
+        for(unsigned c = se.componentsNum; c--; ) {
+            FSnapshotComponent sc;
+
+            memcpy(&sc, bufferRead(Reader, sizeof(sc)), sizeof(sc));
+
+            const void* data = bufferRead(Reader, sc.size);
+            const FComponent* com = f_component__array[sc.bitId];
+            FComponentInstance* instance = e->componentsTable[sc.bitId];
+
+            instance->component = com;
+            instance->entity = e;
+
+            if(com->deserialize) {
+                com->deserialize(instance->buffer, data, sc.size);
+            } else {
+                memcpy(instance->buffer, data, sc.size);
+            }
+        }
+    }
+
+    if(Apply) {
+        f_entity__restoreEnd();
+    }
+
+    ok = true;
+
+done:
+    f_bitfield_free(bits);
+    f_bitfield_free(handles);
+
+    return ok;
+}
+
+bool f_snapshot_restore(const FSnapshot* Snapshot)
+{
+    FSnapshotReader reader = {
+        (const uint8_t*)Snapshot->buffer,
+        0,
+        Snapshot->size - offsetof(FSnapshot, buffer)
+    };
+
+    // Validate the whole buffer before tearing down the current world
+    if(!readWorld(&reader, false)) {
+        f_out__error("f_snapshot_restore: Invalid snapshot");
+
+        return false;
+    }
+
+    reader.offset = 0;
+    readWorld(&reader, true);
+
+    return true;
+}
@@ -0,0 +1,34 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef F_INC_ECS_SNAPSHOT_P_H
+#define F_INC_ECS_SNAPSHOT_P_H
+
+#include "../general/f_system_includes.h"
+
+typedef struct FSnapshot FSnapshot;
+
+extern FSnapshot* f_snapshot_new(void);
+extern FSnapshot* f_snapshot_newFromBuffer(const void* Buffer, size_t Size);
+extern void f_snapshot_free(FSnapshot* Snapshot);
+
+extern const void* f_snapshot_bufferGet(const FSnapshot* Snapshot);
+extern size_t f_snapshot_sizeGet(const FSnapshot* Snapshot);
+
+extern bool f_snapshot_restore(const FSnapshot* Snapshot);
+
+#endif // F_INC_ECS_SNAPSHOT_P_H
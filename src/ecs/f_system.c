@@ -18,9 +18,31 @@
 #include "f_system.v.h"
 #include <faur.v.h>
 
+// Insertion repair gives up after this many compares per entity
+#define F__SORT_REPAIR_BUDGET 8
+
+// Compact when holes pass this fraction of the entities array, so systems
+// that are not being run don't grow without bound
+#define F__HOLES_MAX_DIV 4
+
+// Entities per task when splitting a thread-safe system across workers
+#define F__TASK_ENTITIES 256
+
+typedef struct {
+    FSystem* system;
+    unsigned start, end; // [start, end) range in system's entities array
+} FSystemTask;
+
 FSystem* const* f_system__array; // [f_system__num]
 unsigned f_system__num;
 
+#if F_CONFIG_DEBUG
+    bool f_system__parallel; // Set while threaded handlers may be running
+#endif
+
+static FSystemTask* g_tasks; // [g_tasksCapacity]
+static unsigned g_tasksCapacity;
+
 void f_system__init(FSystem* const* Systems, size_t SystemsNum)
 {
     f_system__array = Systems;
@@ -29,8 +51,8 @@ void f_system__init(FSystem* const* Systems, size_t SystemsNum)
     for(unsigned s = f_system__num; s--; ) {
         FSystem* sys = f_system__array[s];
 
-        sys->entities = f_list_new();
-        sys->componentBits = f_bitfield_new(f_component__num);
+        sys->bitId = s;
+        f_bitfield__init(&sys->componentBits, f_component__num);
 
         for(unsigned c = sys->componentsNum; c--; ) {
             #if F_CONFIG_DEBUG
@@ -42,7 +64,29 @@ void f_system__init(FSystem* const* Systems, size_t SystemsNum)
                 }
             #endif
 
-            f_bitfield_set(sys->componentBits, sys->components[c]->bitId);
+            f_bitfield_set(&sys->componentBits, sys->components[c]->bitId);
+        }
+
+        f_bitfield__init(&sys->componentBitsWrite, f_component__num);
+
+        if(sys->componentsWrite == NULL) {
+            // Without a declared write set, assume it changes everything
+            for(unsigned c = sys->componentsNum; c--; ) {
+                f_bitfield_set(
+                    &sys->componentBitsWrite, sys->components[c]->bitId);
+            }
+        } else {
+            for(const FComponent** c = sys->componentsWrite; *c; c++) {
+                #if F_CONFIG_DEBUG
+                    if(!f_bitfield_test(&sys->componentBits, (*c)->bitId)) {
+                        F__FATAL("%s writes to %s but does not declare it",
+                                 sys->stringId,
+                                 (*c)->stringId);
+                    }
+                #endif
+
+                f_bitfield_set(&sys->componentBitsWrite, (*c)->bitId);
+            }
         }
     }
 }
@@ -52,30 +96,365 @@ void f_system__uninit(void)
     for(unsigned s = f_system__num; s--; ) {
         FSystem* sys = f_system__array[s];
 
-        f_list_free(sys->entities);
-        f_bitfield_free(sys->componentBits);
+        f_mem_free(sys->entities);
+        f_mem_free(sys->entitiesScratch);
+        f_bitfield__uninit(&sys->componentBits);
+        f_bitfield__uninit(&sys->componentBitsWrite);
+    }
+
+    f_mem_free(g_tasks);
+}
+
+static void entitiesGrow(FSystem* System)
+{
+    unsigned capacity = System->entitiesCapacity
+                            ? System->entitiesCapacity * 2 : 16;
+    void** entities = f_mem_malloc(capacity * sizeof(FEntity*));
+
+    if(System->entities) {
+        memcpy(entities,
+               System->entities,
+               System->entitiesNum * sizeof(FEntity*));
+
+        f_mem_free(System->entities);
+    }
+
+    if(System->compare) {
+        f_mem_free(System->entitiesScratch);
+        System->entitiesScratch = f_mem_malloc(capacity * sizeof(FEntity*));
+    }
+
+    System->entities = entities;
+    System->entitiesCapacity = capacity;
+}
+
+static void compact(FSystem* System)
+{
+    unsigned num = 0;
+
+    for(unsigned i = 0; i < System->entitiesNum; i++) {
+        FEntity* e = System->entities[i];
+
+        if(e != NULL) {
+            e->systemSlots[System->bitId] = num;
+            System->entities[num++] = e;
+        }
+    }
+
+    System->entitiesNum = num;
+    System->entitiesHoles = 0;
+}
+
+void f_system__entityAdd(FSystem* System, FEntity* Entity)
+{
+    #if F_CONFIG_DEBUG
+        if(Entity->systemSlots[System->bitId] != F_SYSTEM__SLOT_NONE) {
+            F__FATAL("f_system__entityAdd(%s, %s): Already added",
+                     System->stringId,
+                     f_entity_idGet(Entity));
+        }
+    #endif
+
+    if(!System->running
+        && System->entitiesHoles > System->entitiesNum / F__HOLES_MAX_DIV) {
+
+        compact(System);
+    }
+
+    if(System->entitiesNum == System->entitiesCapacity) {
+        entitiesGrow(System);
+    }
+
+    Entity->systemSlots[System->bitId] = System->entitiesNum;
+    System->entities[System->entitiesNum++] = Entity;
+}
+
+void f_system__entityRemove(FSystem* System, FEntity* Entity)
+{
+    unsigned slot = Entity->systemSlots[System->bitId];
+
+    if(slot == F_SYSTEM__SLOT_NONE) {
+        return;
+    }
+
+    System->profile.removed++;
+
+    if(System->compare || System->running || System->entitiesHoles > 0) {
+        // Keep order, run loop's place or holes, compact on the next run
+        System->entities[slot] = NULL;
+        System->entitiesHoles++;
+    } else {
+        FEntity* last = System->entities[--System->entitiesNum];
+
+        System->entities[slot] = last;
+        last->systemSlots[System->bitId] = slot;
+    }
+
+    Entity->systemSlots[System->bitId] = F_SYSTEM__SLOT_NONE;
+}
+
+static inline int sortCompare(FSystem* System, const FEntity* A, const FEntity* B)
+{
+    System->profile.sortCompares++;
+
+    return System->compare(A, B);
+}
+
+static int sortMergeCompare(void* Context, const void* A, const void* B)
+{
+    return sortCompare(Context, A, B);
+}
+
+static void sortFull(FSystem* System)
+{
+    void** sorted = f_array__sortMerge(System->entities,
+                                       System->entitiesScratch,
+                                       System->entitiesNum,
+                                       sortMergeCompare,
+                                       System);
+
+    if(sorted != System->entities) {
+        System->entitiesScratch = System->entities;
+        System->entities = sorted;
+    }
+}
+
+static bool sortRepair(FSystem* System)
+{
+    void** entities = System->entities;
+    unsigned num = System->entitiesNum;
+    unsigned budget = num * F__SORT_REPAIR_BUDGET;
+
+    // Insertion sort, linear on the nearly-sorted array from last run
+    for(unsigned i = 1; i < num; i++) {
+        FEntity* e = entities[i];
+        unsigned j = i;
+
+        while(j > 0 && sortCompare(System, entities[j - 1], e) > 0) {
+            entities[j] = entities[j - 1];
+            j--;
+        }
+
+        entities[j] = e;
+
+        if(System->profile.sortCompares > budget) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void sort(FSystem* System)
+{
+    System->profile.sortCompares = 0;
+
+    if(System->entitiesNum < 2) {
+        return;
+    }
+
+    if(!sortRepair(System)) {
+        // Too far out of order, finish with a full merge sort
+        sortFull(System);
+    }
+
+    for(unsigned i = System->entitiesNum; i--; ) {
+        FEntity* e = System->entities[i];
+
+        e->systemSlots[System->bitId] = i;
     }
 }
 
-void f_system_run(const FSystem* System)
+static void prepare(FSystem* System)
 {
+    System->profile.handled = 0;
+    System->profile.kicked = 0;
+    System->profile.removed = 0;
+
+    if(System->entitiesHoles > 0) {
+        compact(System);
+    }
+
+    System->profile.entities = System->entitiesNum;
+
     if(System->compare) {
-        f_list_sort(System->entities, (FCallListCompare*)System->compare);
+        sort(System);
     }
 
-    if(System->onlyActiveEntities) {
-        F_LIST_ITERATE(System->entities, FEntity*, entity) {
-            if(f_entity_activeGet(entity)) {
+    System->running = true;
+}
+
+void f_system_run(FSystem* System)
+{
+    uint32_t start = f_time_usGet();
+
+    prepare(System);
+
+    // Handlers may remove the current entity, which fills or empties its slot
+    for(unsigned i = 0; i < System->entitiesNum; ) {
+        FEntity* entity = System->entities[i];
+
+        if(entity != NULL) {
+            if(!System->onlyActiveEntities || f_entity_activeGet(entity)) {
                 System->handler(entity);
+                System->profile.handled++;
             } else {
                 f_entity__flushFromSystemsActive(entity);
+                System->profile.kicked++;
             }
         }
-    } else {
-        F_LIST_ITERATE(System->entities, FEntity*, entity) {
-            System->handler(entity);
+
+        if(i < System->entitiesNum && System->entities[i] == entity) {
+            i++;
+        }
+    }
+
+    System->running = false;
+
+    f_entity__flushFromSystems();
+
+    System->profile.timeUs = f_time_usGet() - start;
+}
+
+static bool conflicts(const FSystem* A, const FSystem* B)
+{
+    return f_bitfield_testAny(&A->componentBitsWrite, &B->componentBits)
+        || f_bitfield_testAny(&B->componentBitsWrite, &A->componentBits);
+}
+
+static void taskAdd(unsigned* TasksNum, FSystem* System, unsigned Start, unsigned End)
+{
+    if(*TasksNum == g_tasksCapacity) {
+        unsigned capacity = g_tasksCapacity ? g_tasksCapacity * 2 : 16;
+        FSystemTask* tasks = f_mem_malloc(capacity * sizeof(FSystemTask));
+
+        if(g_tasks) {
+            memcpy(tasks, g_tasks, g_tasksCapacity * sizeof(FSystemTask));
+            f_mem_free(g_tasks);
+        }
+
+        g_tasks = tasks;
+        g_tasksCapacity = capacity;
+    }
+
+    FSystemTask* t = &g_tasks[(*TasksNum)++];
+
+    t->system = System;
+    t->start = Start;
+    t->end = End;
+}
+
+static void taskRun(void* Context, unsigned Index)
+{
+    const FSystemTask* t = &((const FSystemTask*)Context)[Index];
+    void** entities = t->system->entities;
+
+    for(unsigned i = t->start; i < t->end; i++) {
+        if(entities[i] != NULL) {
+            t->system->handler(entities[i]);
+        }
+    }
+}
+
+static void runBatch(FSystem* const* Systems, unsigned SystemsNum)
+{
+    uint32_t start = f_time_usGet();
+    unsigned tasksNum = 0;
+
+    for(unsigned s = 0; s < SystemsNum; s++) {
+        FSystem* sys = Systems[s];
+
+        prepare(sys);
+
+        // Kick inactive entities now, handlers must not change system arrays
+        if(sys->onlyActiveEntities) {
+            for(unsigned i = 0; i < sys->entitiesNum; i++) {
+                FEntity* e = sys->entities[i];
+
+                if(e != NULL && !f_entity_activeGet(e)) {
+                    f_entity__flushFromSystemsActive(e);
+                    sys->profile.kicked++;
+                }
+            }
+        }
+
+        sys->profile.handled =
+            sys->profile.entities - sys->profile.kicked;
+
+        // Sorted systems stay in one task to keep their handler order
+        unsigned step = sys->compare ? sys->entitiesNum : F__TASK_ENTITIES;
+
+        for(unsigned i = 0; i < sys->entitiesNum; i += step) {
+            taskAdd(&tasksNum,
+                    sys,
+                    i,
+                    f_math_minu(i + step, sys->entitiesNum));
         }
     }
 
+    #if F_CONFIG_DEBUG
+        f_system__parallel = true;
+    #endif
+
+    f_platform_api__taskRun(taskRun, g_tasks, tasksNum);
+
+    #if F_CONFIG_DEBUG
+        f_system__parallel = false;
+    #endif
+
+    for(unsigned s = SystemsNum; s--; ) {
+        Systems[s]->running = false;
+    }
+
     f_entity__flushFromSystems();
+
+    // Systems in a batch overlap, so they all report the batch's time
+    uint32_t time = f_time_usGet() - start;
+
+    for(unsigned s = SystemsNum; s--; ) {
+        Systems[s]->profile.timeUs = time;
+    }
+}
+
+void f_system_runParallel(FSystem* const* Systems, unsigned SystemsNum)
+{
+    for(unsigned s = 0; s < SystemsNum; ) {
+        if(!Systems[s]->threadSafe) {
+            f_system_run(Systems[s++]);
+
+            continue;
+        }
+
+        // Gather the next run of thread-safe systems that can share a batch
+        unsigned end = s + 1;
+
+        for(; end < SystemsNum && Systems[end]->threadSafe; end++) {
+            bool conflict = false;
+
+            for(unsigned b = s; b < end; b++) {
+                if(conflicts(Systems[b], Systems[end])) {
+                    conflict = true;
+
+                    break;
+                }
+            }
+
+            if(conflict) {
+                break;
+            }
+        }
+
+        runBatch(Systems + s, end - s);
+        s = end;
+    }
+}
+
+unsigned f_system_sortComparesGet(const FSystem* System)
+{
+    return System->profile.sortCompares;
+}
+
+const FSystemProfile* f_system_profileGet(const FSystem* System)
+{
+    return &System->profile;
 }
@@ -30,15 +30,34 @@ typedef struct FSystem FSystem;
 typedef void FCallSystemHandler(FEntity* Entity);
 typedef int FCallSystemSort(const FEntity* A, const FEntity* B);
 
+typedef struct {
+    uint32_t timeUs; // wall time of the last run, including sort and flush
+    unsigned entities; // entities in the system when the last run started
+    unsigned handled; // handler calls in the last run
+    unsigned kicked; // inactive entities flushed out during the last run
+    unsigned removed; // entities that left since the last run started
+    unsigned sortCompares; // compare calls made by the last run's sort
+} FSystemProfile;
+
 struct FSystem {
     const char* stringId; // unique string ID
-    FList* entities; // entities currently picked up by this system
+    void** entities; // [entitiesNum] FEntity* picked up by this system
+    void** entitiesScratch; // [entitiesCapacity] merge sort buffer
     const FComponent** components; // [componentsNum]
-    FBitfield* componentBits; // IDs of components that this system works on
-    FCallSystemHandler* handler; // invoked on each entity in list
-    FCallSystemSort* compare; // for sorting the entities list before running
+    const FComponent** componentsWrite; // NULL-terminated, or NULL for all
+    FBitfield componentBits; // IDs of components that this system works on
+    FBitfield componentBitsWrite; // IDs of components that handler changes
+    FCallSystemHandler* handler; // invoked on each entity in array
+    FCallSystemSort* compare; // for sorting the entities array before running
     unsigned componentsNum; // length of components array
+    unsigned entitiesNum; // used length of entities array, including holes
+    unsigned entitiesCapacity; // allocated length of entities array
+    unsigned entitiesHoles; // NULL slots left by removals, compacted on run or add
+    unsigned bitId; // unique number ID
+    FSystemProfile profile; // counters and timing of the last run
     bool onlyActiveEntities; // kick out entities that are not marked active
+    bool threadSafe; // handler only touches its entity's declared components
+    bool running; // removals leave holes instead of swapping
 };
 
 #define F_SYSTEM(Name, Handler, SortCompare, OnlyActiveEntities, ...) \
@@ -52,6 +71,31 @@ struct FSystem {
         .stringId = F_STRINGIFY(Name),                                \
     }
 
-extern void f_system_run(const FSystem* System);
+#define F_SYSTEM_WRITES(...) (const FComponent*[]){__VA_ARGS__, NULL}
+
+// Threaded handlers run at the same time on worker threads, and may only
+// touch their own entity's declared components. They must not call
+// f_entity_new, f_entity_newId, f_entity_newBatch, f_entity_debugSet,
+// f_entity_refInc, f_entity_refDec, f_entity_removedSet,
+// f_entity_activeSet, f_entity_activeSetPermanent, f_entity_muteInc,
+// f_entity_muteDec, f_entity_componentAdd, or f_entity_idGet on an entity
+// whose ID string was not made yet. Debug builds stop on these.
+#define F_SYSTEM_THREADED(Name, Handler, SortCompare, OnlyActiveEntities, Writes, ...) \
+    FSystem Name = {                                                  \
+        .handler = Handler,                                           \
+        .compare = SortCompare,                                       \
+        .onlyActiveEntities = OnlyActiveEntities,                     \
+        .threadSafe = true,                                           \
+        .components = (const FComponent*[]){__VA_ARGS__},             \
+        .componentsWrite = Writes,                                    \
+        .componentsNum = sizeof((const FComponent*[]){__VA_ARGS__})   \
+                            / sizeof(const FComponent*),              \
+        .stringId = F_STRINGIFY(Name),                                \
+    }
+
+extern void f_system_run(FSystem* System);
+extern void f_system_runParallel(FSystem* const* Systems, unsigned SystemsNum);
+extern unsigned f_system_sortComparesGet(const FSystem* System);
+extern const FSystemProfile* f_system_profileGet(const FSystem* System);
 
 #endif // F_INC_ECS_SYSTEM_P_H
@@ -20,15 +20,19 @@
 
 #include "f_system.p.h"
 
+#define F_SYSTEM__SLOT_NONE UINT_MAX
+
 extern FSystem* const* f_system__array;
 extern unsigned f_system__num;
 
+#if F_CONFIG_DEBUG
+    extern bool f_system__parallel;
+#endif
+
 extern void f_system__init(FSystem* const* Systems, size_t SystemsNum);
 extern void f_system__uninit(void);
 
-static inline FListNode* f_system__entityAdd(const FSystem* System, FEntity* Entity)
-{
-    return f_list_addLast(System->entities, Entity);
-}
+extern void f_system__entityAdd(FSystem* System, FEntity* Entity);
+extern void f_system__entityRemove(FSystem* System, FEntity* Entity);
 
 #endif // F_INC_ECS_SYSTEM_V_H
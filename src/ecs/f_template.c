@@ -29,9 +29,9 @@ static FTemplate* templateNew(const char* Id, const FBlock* Block)
         t->init = (FCallEntityInit*)f_sym_address(Id);
     }
 
-    t->componentsOwn = f_list_new();
-    t->componentsAll = f_list_new();
-    t->componentsBits = f_bitfield_new(f_component__num);
+    t->componentsOwn = f_array_new();
+    t->componentsAll = f_array_new();
+    f_bitfield__init(&t->componentsBits, f_component__num);
 
     char* parentId = f_str_prefixGetToLast(Id, '_');
 
@@ -44,9 +44,9 @@ static FTemplate* templateNew(const char* Id, const FBlock* Block)
 
         t->parent = parentTemplate;
 
-        F_LIST_ITERATE(parentTemplate->componentsAll, const FComponent*, c) {
-            f_list_addLast(t->componentsAll, (void*)c);
-            f_bitfield_set(t->componentsBits, c->bitId);
+        F_ARRAY_ITERATE(parentTemplate->componentsAll, const FComponent*, c) {
+            f_array_add(t->componentsAll, (void*)c);
+            f_bitfield_set(&t->componentsBits, c->bitId);
 
             t->data[c->bitId] = parentTemplate->data[c->bitId];
         }
@@ -69,15 +69,15 @@ static FTemplate* templateNew(const char* Id, const FBlock* Block)
                 continue;
             }
 
-            if(f_bitfield_test(t->componentsBits, c->bitId)) {
+            if(f_bitfield_test(&t->componentsBits, c->bitId)) {
                 f_block__merge(
                     b, f_block_keyGetBlock(t->parent->block, c->stringId));
             } else {
-                f_list_addLast(t->componentsAll, (void*)c);
-                f_bitfield_set(t->componentsBits, c->bitId);
+                f_array_add(t->componentsAll, (void*)c);
+                f_bitfield_set(&t->componentsBits, c->bitId);
             }
 
-            f_list_addLast(t->componentsOwn, (void*)c);
+            f_array_add(t->componentsOwn, (void*)c);
 
             t->data[c->bitId] = f_component__dataInit(c, b);
         }
@@ -85,27 +85,31 @@ static FTemplate* templateNew(const char* Id, const FBlock* Block)
         t->block = t->parent->block;
     }
 
-    f_hash_add(g_templates, f_str_dup(Id), t);
+    t->archetype = f_archetype__get(&t->componentsBits);
+
+    t->stringId = f_strid_stringGet(f_strid_new(Id));
+
+    f_hash_add(g_templates, t->stringId, t);
 
     return t;
 }
 
 static void templateFree(FTemplate* Template)
 {
-    F_LIST_ITERATE(Template->componentsOwn, const FComponent*, c) {
+    F_ARRAY_ITERATE(Template->componentsOwn, const FComponent*, c) {
         f_component__dataFree(c, Template->data[c->bitId]);
     }
 
-    f_list_free(Template->componentsOwn);
-    f_list_free(Template->componentsAll);
-    f_bitfield_free(Template->componentsBits);
+    f_array_free(Template->componentsOwn);
+    f_array_free(Template->componentsAll);
+    f_bitfield__uninit(&Template->componentsBits);
 
     f_mem_free(Template);
 }
 
 void f_template__init(void)
 {
-    g_templates = f_hash_newStr(256, true);
+    g_templates = f_hash_newStr(256, false);
 }
 
 void f_template__uninit(void)
@@ -152,7 +156,7 @@ void f_template_load(const char* Dir)
     FList* blocks = f_list_new();
 
     process_dir(Dir, blocks);
-    f_list_sort(blocks, (FCallListCompare*)cmp_blocks);
+    f_list_sortStable(blocks, (FCallListCompare*)cmp_blocks);
 
     F_LIST_ITERATE(blocks, const FBlock*, b) {
         templateNew(f_block_lineGetString(b, 0), b);
@@ -161,19 +165,40 @@ void f_template_load(const char* Dir)
     f_list_freeEx(blocks, (FCallFree*)f_block_free);
 }
 
-const FTemplate* f_template__get(const char* Id)
+static const FTemplate* templateGet(const char* Id, const FStrId* StrId, unsigned Count)
 {
-    FTemplate* t = f_hash_get(g_templates, Id);
+    FTemplate* t = StrId ? f_hash_getStrId(g_templates, StrId)
+                         : f_hash_get(g_templates, Id);
 
     if(t == NULL) {
         F__FATAL("Unknown template '%s'", Id);
     }
 
-    t->iNumber++;
+    t->iNumber += Count;
 
     return t;
 }
 
+const FTemplate* f_template__get(const char* Id)
+{
+    return templateGet(Id, NULL, 1);
+}
+
+const FTemplate* f_template__getBatch(const char* Id, unsigned Count)
+{
+    return templateGet(Id, NULL, Count);
+}
+
+const FTemplate* f_template__getStrId(const FStrId* Id)
+{
+    return templateGet(Id->string, Id, 1);
+}
+
+const FTemplate* f_template__find(const char* Id)
+{
+    return f_hash_get(g_templates, Id);
+}
+
 void f_template__initRun(const FTemplate* Template, FEntity* Entity, const void* Context)
 {
     if(Template->parent) {
@@ -22,14 +22,19 @@
 
 typedef struct FTemplate FTemplate;
 
+#include "../data/f_array.v.h"
 #include "../data/f_bitfield.v.h"
+#include "../ecs/f_archetype.v.h"
+#include "../strings/f_strid.v.h"
 
 struct FTemplate {
+    const char* stringId; // Template name, interned
     const FTemplate* parent; // Template chain
     FCallEntityInit* init; // Optional, runs after comps init and parent init
-    FList* componentsOwn; // FList<const FComponent*> this template only
-    FList* componentsAll; // FList<const FComponent*> this template or parent
-    FBitfield* componentsBits; // Set if this template or parent has component
+    FArray* componentsOwn; // FArray<const FComponent*> this template only
+    FArray* componentsAll; // FArray<const FComponent*> template or parent
+    FBitfield componentsBits; // Set if this template or parent has component
+    FArchetype* archetype; // Where this template's entities keep components
     const FBlock* block; // Only valid while reading current config file
     unsigned iNumber; // Incremented by every new entity
     void* data[1]; // [f_component__num] Loaded config data, or NULL
@@ -40,6 +45,9 @@ extern void f_template__init(void);
 extern void f_template__uninit(void);
 
 extern const FTemplate* f_template__get(const char* Id);
+extern const FTemplate* f_template__getBatch(const char* Id, unsigned Count);
+extern const FTemplate* f_template__getStrId(const FStrId* Id);
+extern const FTemplate* f_template__find(const char* Id);
 
 extern void f_template__initRun(const FTemplate* Template, FEntity* Entity, const void* Context);
 
@@ -29,6 +29,7 @@
 F_EXTERN_C_START
 #include "collision/f_collide.p.h"
 #include "collision/f_grid.p.h"
+#include "data/f_array.p.h"
 #include "data/f_bitfield.p.h"
 #include "data/f_block.p.h"
 #include "data/f_hash.p.h"
@@ -38,6 +39,7 @@ F_EXTERN_C_START
 #include "ecs/f_component.p.h"
 #include "ecs/f_ecs.p.h"
 #include "ecs/f_entity.p.h"
+#include "ecs/f_snapshot.p.h"
 #include "ecs/f_system.p.h"
 #include "ecs/f_template.p.h"
 #include "files/f_blob.p.h"
@@ -71,6 +73,7 @@ F_EXTERN_C_START
 #include "math/f_math.p.h"
 #include "math/f_random.p.h"
 #include "math/f_vec.p.h"
+#include "memory/f_arena.p.h"
 #include "memory/f_mem.p.h"
 #include "memory/f_pool.p.h"
 #include "platform/video/f_gamebuino_video.p.h"
@@ -78,6 +81,7 @@ F_EXTERN_C_START
 #include "sound/f_music.p.h"
 #include "sound/f_sample.p.h"
 #include "strings/f_str.p.h"
+#include "strings/f_strid.p.h"
 #include "time/f_time.p.h"
 #include "time/f_timer.p.h"
 F_EXTERN_C_END
@@ -21,13 +21,16 @@
 #include "faur.h"
 
 F_EXTERN_C_START
+#include "data/f_array.v.h"
 #include "data/f_block.v.h"
 #include "data/f_hash.v.h"
 #include "data/f_list.v.h"
+#include "ecs/f_archetype.v.h"
 #include "ecs/f_collection.v.h"
 #include "ecs/f_component.v.h"
 #include "ecs/f_ecs.v.h"
 #include "ecs/f_entity.v.h"
+#include "ecs/f_snapshot.v.h"
 #include "ecs/f_system.v.h"
 #include "ecs/f_template.v.h"
 #include "files/f_blob.v.h"
@@ -56,6 +59,7 @@ F_EXTERN_C_START
 #include "input/f_input.v.h"
 #include "math/f_fix.v.h"
 #include "math/f_random.v.h"
+#include "memory/f_arena.v.h"
 #include "memory/f_mem.v.h"
 #include "memory/f_pool.v.h"
 #include "platform/f_platform.v.h"
@@ -74,6 +78,7 @@ F_EXTERN_C_START
 #include "sound/f_sample.v.h"
 #include "sound/f_sound.v.h"
 #include "strings/f_str.v.h"
+#include "strings/f_strid.v.h"
 #include "time/f_timer.v.h"
 F_EXTERN_C_END
 
@@ -247,6 +247,19 @@ void f_console__draw(void)
         #if F_CONFIG_DEBUG_ALLOC
             printBytes(f_mem__tally, "now");
             printBytes(f_mem__top, "top");
+            f_font_printf("%u allocs/frame\n", f_mem__allocsFrame);
+
+            for(int p = 0; p < F_POOL__NUM; p++) {
+                const FPoolStats* stats = f_pool__statsGet((FPoolId)p);
+
+                if(stats->allocsFrame > 0) {
+                    f_font_printf("%s %u/%u +%u\n",
+                                  f_pool__nameGet((FPoolId)p),
+                                  stats->objectsLive,
+                                  stats->objectsTop,
+                                  stats->allocsFrame);
+                }
+            }
         #endif
 
         unsigned eTotal = f_entity__numGet();
@@ -255,7 +268,21 @@ void f_console__draw(void)
         f_font_printf("%u entities\n", eTotal);
 
         if(eTotal > 0) {
-            f_font_printf("%u active (%u%%)", eActive, 100 * eActive / eTotal);
+            f_font_printf("%u active (%u%%)\n",
+                          eActive,
+                          100 * eActive / eTotal);
+        }
+
+        f_color__colorSetInternal(F_COLOR__PAL_GRAY1);
+
+        for(unsigned s = 0; s < f_system__num; s++) {
+            const FSystem* system = f_system__array[s];
+
+            f_font_printf("%s %uus %u/%u\n",
+                          system->stringId,
+                          (unsigned)system->profile.timeUs,
+                          system->profile.handled,
+                          system->profile.entities);
         }
     }
 
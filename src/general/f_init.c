@@ -20,6 +20,8 @@
 
 static const FPack* g_packs[] = {
     &f_pack__pool,
+    &f_pack__arena,
+    &f_pack__strid,
     &f_pack__console_0,
     &f_pack__embed,
     &f_pack__platform,
@@ -76,6 +76,7 @@ static void pending_handle(void)
             #endif
 
             f_pool_release(f_listintr_pop(&g_stack));
+            f_pool__trimAll();
 
             current = f_listintr_peek(&g_stack);
             resetFps = current && current->stage == F__STATE_STAGE_TICK;
@@ -357,6 +358,11 @@ bool f_state__runStep(void)
         f_screen__draw();
 
         f_fps__frame();
+
+        #if F_CONFIG_DEBUG_ALLOC
+            f_mem__frame();
+            f_pool__frame();
+        #endif
     } else {
         #if F_CONFIG_DEBUG
             f_out__state("'%s' running %s", s->name, g_stageNames[s->stage]);
@@ -365,6 +371,8 @@ bool f_state__runStep(void)
         s->handler();
     }
 
+    f_arena__frameReset();
+
     return true;
 }
 
@@ -40,7 +40,8 @@ const FPack f_pack__sym = {
 
 void f_sym_set(const char* Name, uintptr_t Value)
 {
-    f_hash_add(g_map, Name, (void*)Value);
+    // Interned, so lookups through an FStrId match by pointer
+    f_hash_add(g_map, f_strid_stringGet(f_strid_new(Name)), (void*)Value);
 }
 
 bool f_sym_test(const char* Name)
@@ -48,47 +49,52 @@ bool f_sym_test(const char* Name)
     return f_hash_contains(g_map, Name);
 }
 
-int f_sym_int(const char* Name)
+static uintptr_t symGet(const char* Caller, const char* Name, const FStrId* Id)
 {
     if(*Name == '\0') {
         return 0;
     }
 
     #if F_CONFIG_DEBUG
-        if(!f_hash_contains(g_map, Name)) {
-            F__FATAL("f_sym_int(%s): Not found", Name);
+        if(Id ? !f_hash_containsStrId(g_map, Id)
+              : !f_hash_contains(g_map, Name)) {
+
+            F__FATAL("%s(%s): Not found", Caller, Name);
         }
+    #else
+        F_UNUSED(Caller);
     #endif
 
-    return (int)(intptr_t)f_hash_get(g_map, Name);
+    return (uintptr_t)(Id ? f_hash_getStrId(g_map, Id)
+                          : f_hash_get(g_map, Name));
 }
 
-unsigned f_sym_intu(const char* Name)
+int f_sym_int(const char* Name)
 {
-    if(*Name == '\0') {
-        return 0;
-    }
+    return (int)(intptr_t)symGet("f_sym_int", Name, NULL);
+}
 
-    #if F_CONFIG_DEBUG
-        if(!f_hash_contains(g_map, Name)) {
-            F__FATAL("f_sym_intu(%s): Not found", Name);
-        }
-    #endif
+int f_sym_intId(const FStrId* Id)
+{
+    return (int)(intptr_t)symGet("f_sym_intId", Id->string, Id);
+}
 
-    return (unsigned)(uintptr_t)f_hash_get(g_map, Name);
+unsigned f_sym_intu(const char* Name)
+{
+    return (unsigned)symGet("f_sym_intu", Name, NULL);
 }
 
-uintptr_t f_sym_address(const char* Name)
+unsigned f_sym_intuId(const FStrId* Id)
 {
-    if(*Name == '\0') {
-        return 0;
-    }
+    return (unsigned)symGet("f_sym_intuId", Id->string, Id);
+}
 
-    #if F_CONFIG_DEBUG
-        if(!f_hash_contains(g_map, Name)) {
-            F__FATAL("f_sym_address(%s): Not found", Name);
-        }
-    #endif
+uintptr_t f_sym_address(const char* Name)
+{
+    return symGet("f_sym_address", Name, NULL);
+}
 
-    return (uintptr_t)f_hash_get(g_map, Name);
+uintptr_t f_sym_addressId(const FStrId* Id)
+{
+    return symGet("f_sym_addressId", Id->string, Id);
 }
@@ -20,6 +20,8 @@
 
 #include "../general/f_system_includes.h"
 
+#include "../strings/f_strid.p.h"
+
 extern void f_sym_set(const char* Name, uintptr_t Value);
 
 #ifndef FAUR_IMPLEMENT_SYM
@@ -29,7 +31,10 @@ extern void f_sym_set(const char* Name, uintptr_t Value);
 extern bool f_sym_test(const char* Name);
 
 extern int f_sym_int(const char* Name);
+extern int f_sym_intId(const FStrId* Id);
 extern unsigned f_sym_intu(const char* Name);
+extern unsigned f_sym_intuId(const FStrId* Id);
 extern uintptr_t f_sym_address(const char* Name);
+extern uintptr_t f_sym_addressId(const FStrId* Id);
 
 #endif // F_INC_GENERAL_SYM_P_H
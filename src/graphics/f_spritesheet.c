@@ -30,7 +30,7 @@ FSpriteSheet* f_spritesheet_new(const char* Path)
         num += f_list_sizeGet(f_block_blocksGet(b));
     }
 
-    FHash* t = f_hash_newStr(f_math_minu(num, 256), true);
+    FHash* t = f_hash_newStr(f_math_minu(num, 256), false);
 
     F_LIST_ITERATE(blocks, const FBlock*, b) {
         char path[256];
@@ -59,7 +59,7 @@ FSpriteSheet* f_spritesheet_new(const char* Path)
             FSprite* sprite = f_sprite_newFromSprite(
                                 sheet, coords.x, coords.y, dim.x, dim.y);
 
-            f_hash_add(t, f_str_dup(id), sprite);
+            f_hash_add(t, f_strid_stringGet(f_strid_new(id)), sprite);
         }
 
         f_sprite_free(sheet);
@@ -80,3 +80,8 @@ const FSprite* f_spritesheet_get(const FSpriteSheet* Sheet, const char* Id)
 {
     return f_hash_get(Sheet, Id);
 }
+
+const FSprite* f_spritesheet_getId(const FSpriteSheet* Sheet, const FStrId* Id)
+{
+    return f_hash_getStrId(Sheet, Id);
+}
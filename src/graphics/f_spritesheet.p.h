@@ -29,5 +29,6 @@ extern FSpriteSheet* f_spritesheet_new(const char* Path);
 extern void f_spritesheet_free(FSpriteSheet* Sheet);
 
 extern const FSprite* f_spritesheet_get(const FSpriteSheet* Sheet, const char* Id);
+extern const FSprite* f_spritesheet_getId(const FSpriteSheet* Sheet, const FStrId* Id);
 
 #endif // F_INC_GRAPHICS_SPRITESHEET_P_H
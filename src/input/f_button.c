@@ -20,13 +20,13 @@
 
 typedef struct {
     FListIntrNode listNode;
-    FList* andButtons; // FList<FPlatformButton*>
+    FArray* andButtons; // FArray<FPlatformButton*>
 } FButtonCombo;
 
 struct FButton {
     FListIntrNode listNode;
     const char* name; // friendly name
-    FList* platformInputs; // FList<FPlatformButton*>
+    FArray* platformInputs; // FArray<FPlatformButton*>
     FListIntr combos; // FListIntr<FButtonCombo*>
     FTimer* autoRepeat;
     bool isClone;
@@ -122,7 +122,7 @@ FButton* f_button_new(void)
     f_listintr_addLast(&g_buttons, b);
 
     b->name = g_defaultName;
-    b->platformInputs = f_list_new();
+    b->platformInputs = f_array_new();
 
     f_listintr_init(&b->combos, FButtonCombo, listNode);
 
@@ -153,10 +153,11 @@ void f_button_free(FButton* Button)
 
     if(!Button->isClone) {
         F_LISTINTR_ITERATE(&Button->combos, FButtonCombo*, combo) {
-            f_list_free(combo->andButtons);
+            f_array_free(combo->andButtons);
+            f_mem_free(combo);
         }
 
-        f_list_free(Button->platformInputs);
+        f_array_free(Button->platformInputs);
     }
 
     f_timer_free(Button->autoRepeat);
@@ -177,7 +178,7 @@ void f_button_bindKey(FButton* Button, FKeyId Id)
             Button->name = g_keyNames[Id];
         }
 
-        f_list_addLast(Button->platformInputs, (FPlatformButton*)k);
+        f_array_add(Button->platformInputs, (FPlatformButton*)k);
     #else
         F_UNUSED(Button);
         F_UNUSED(Id);
@@ -196,7 +197,7 @@ void f_button_bindButton(FButton* Button, const FController* Controller, FButton
         Button->name = g_buttonNames[Id];
     }
 
-    f_list_addLast(Button->platformInputs, (FPlatformButton*)b);
+    f_array_add(Button->platformInputs, (FPlatformButton*)b);
 }
 
 void f_button_bindCombo(FButton* Button, const FController* Controller, FButtonId Id, ...)
@@ -204,19 +205,22 @@ void f_button_bindCombo(FButton* Button, const FController* Controller, FButtonI
     va_list args;
     va_start(args, Id);
 
-    FList* combo = f_list_new();
+    FButtonCombo* combo = f_mem_malloc(sizeof(FButtonCombo));
+
+    combo->andButtons = f_array_new();
 
     for(int i = Id; i != F_BUTTON_INVALID; i = va_arg(args, int)) {
         const FPlatformButton* b =
             f_platform_api__inputButtonGet(Controller, i);
 
         if(b) {
-            f_list_addLast(combo, (FPlatformButton*)b);
+            f_array_add(combo->andButtons, (FPlatformButton*)b);
         }
     }
 
-    if(f_list_sizeIsEmpty(combo)) {
-        f_list_free(combo);
+    if(f_array_sizeIsEmpty(combo->andButtons)) {
+        f_array_free(combo->andButtons);
+        f_mem_free(combo);
     } else {
         f_listintr_addFirst(&Button->combos, combo);
     }
@@ -226,7 +230,7 @@ void f_button_bindCombo(FButton* Button, const FController* Controller, FButtonI
 
 bool f_button_isWorking(const FButton* Button)
 {
-    return !f_list_sizeIsEmpty(Button->platformInputs)
+    return !f_array_sizeIsEmpty(Button->platformInputs)
         || !f_listintr_sizeIsEmpty(&Button->combos);
 }
 
@@ -272,7 +276,7 @@ void f_input_button__tick(void)
     F_LISTINTR_ITERATE(&g_buttons, FButton*, b) {
         bool pressed = false;
 
-        F_LIST_ITERATE(b->platformInputs, const FPlatformButton*, pb) {
+        F_ARRAY_ITERATE(b->platformInputs, const FPlatformButton*, pb) {
             if(f_platform_api__inputButtonPressGet(pb)) {
                 pressed = true;
                 goto done;
@@ -281,10 +285,10 @@ void f_input_button__tick(void)
 
         if(!f_listintr_sizeIsEmpty(&b->combos)) {
             F_LISTINTR_ITERATE(&b->combos, FButtonCombo*, combo) {
-                F_LIST_ITERATE(combo->andButtons, const FPlatformButton*, pb) {
+                F_ARRAY_ITERATE(combo->andButtons, const FPlatformButton*, pb) {
                     if(!f_platform_api__inputButtonPressGet(pb)) {
                         break;
-                    } else if(F_LIST_IS_LAST()) {
+                    } else if(F_ARRAY_IS_LAST()) {
                         pressed = true;
                         goto done;
                     }
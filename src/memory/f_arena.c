@@ -0,0 +1,181 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "f_arena.v.h"
+#include <faur.v.h>
+
+#if F_CONFIG_TRAIT_LOW_MEM
+    #define F__FRAME_BLOCK_SIZE (2 * 1024)
+#else
+    #define F__FRAME_BLOCK_SIZE (64 * 1024)
+#endif
+
+// Halve a grown block after this many resets in a row used under a quarter
+#define F__SHRINK_RESETS 120
+
+typedef struct FArenaBlock FArenaBlock;
+
+struct FArenaBlock {
+    FArenaBlock* nextBlock; // Previously filled block
+    size_t size; // Bytes available in buffer
+    FMaxMemAlignType buffer[]; // Memory space for allocations
+};
+
+struct FArena {
+    FArenaBlock* blockList; // Current block, followed by filled ones
+    size_t blockSize; // Size of new blocks, grows to fit a whole frame
+    size_t blockSizeStart; // Original blockSize, the floor when shrinking
+    size_t used; // Bytes handed out from the current block
+    unsigned calmResets; // Resets in a row that used little of the block
+};
+
+static FArena* g_frame;
+
+static void f_arena__init(void)
+{
+    g_frame = f_arena_new(F__FRAME_BLOCK_SIZE);
+}
+
+static void f_arena__uninit(void)
+{
+    f_arena_free(g_frame);
+}
+
+const FPack f_pack__arena = {
+    "Arena",
+    f_arena__init,
+    f_arena__uninit
+};
+
+static void blocksFree(FArenaBlock* Block)
+{
+    while(Block != NULL) {
+        FArenaBlock* nextBlock = Block->nextBlock;
+
+        f_mem_free(Block);
+
+        Block = nextBlock;
+    }
+}
+
+static void blockNew(FArena* Arena, size_t Size)
+{
+    size_t size = f_math_maxz(Arena->blockSize, Size);
+    FArenaBlock* b = f_mem_malloc(sizeof(FArenaBlock) + size);
+
+    b->nextBlock = Arena->blockList;
+    b->size = size;
+
+    Arena->blockList = b;
+    Arena->used = 0;
+}
+
+FArena* f_arena_new(size_t BlockSize)
+{
+    FArena* a = f_mem_mallocz(sizeof(FArena));
+
+    a->blockSize = BlockSize;
+    a->blockSizeStart = BlockSize;
+
+    return a;
+}
+
+void f_arena_free(FArena* Arena)
+{
+    if(Arena == NULL) {
+        return;
+    }
+
+    blocksFree(Arena->blockList);
+
+    f_mem_free(Arena);
+}
+
+void* f_arena_alloc(FArena* Arena, size_t Size)
+{
+    size_t size = (Size + sizeof(FMaxMemAlignType) - 1)
+                    & ~(sizeof(FMaxMemAlignType) - 1);
+
+    if(Arena->blockList == NULL
+        || Arena->used + size > Arena->blockList->size) {
+        blockNew(Arena, size);
+    }
+
+    void* buffer = (uint8_t*)Arena->blockList->buffer + Arena->used;
+
+    Arena->used += size;
+
+    return buffer;
+}
+
+void f_arena_reset(FArena* Arena)
+{
+    FArenaBlock* b = Arena->blockList;
+
+    if(b == NULL) {
+        return;
+    }
+
+    if(b->nextBlock != NULL) {
+        // Overflowed, merge into one block big enough for all of it
+        size_t total = 0;
+
+        for(FArenaBlock* block = b; block != NULL; block = block->nextBlock) {
+            total += block->size;
+        }
+
+        blocksFree(b);
+
+        Arena->blockList = NULL;
+        Arena->blockSize = total;
+        Arena->calmResets = 0;
+
+        blockNew(Arena, total);
+    } else if(Arena->blockSize > Arena->blockSizeStart
+                && Arena->used <= b->size / 4
+                && ++Arena->calmResets >= F__SHRINK_RESETS) {
+
+        // A spike grew the block, give memory back once things calm down
+        blocksFree(b);
+
+        Arena->blockList = NULL;
+        Arena->blockSize = f_math_maxz(
+                            Arena->blockSizeStart, Arena->blockSize / 2);
+        Arena->calmResets = 0;
+    } else {
+        if(Arena->used > b->size / 4) {
+            Arena->calmResets = 0;
+        }
+
+        #if F_CONFIG_DEBUG
+            // Make stale pointers into the arena easier to spot
+            memset(b->buffer, 0xa5, Arena->used);
+        #endif
+    }
+
+    Arena->used = 0;
+}
+
+void* f_arena_frameAlloc(size_t Size)
+{
+    return f_arena_alloc(g_frame, Size);
+}
+
+void f_arena__frameReset(void)
+{
+    f_arena_reset(g_frame);
+}
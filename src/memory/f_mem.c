@@ -15,16 +15,94 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define FAUR_IMPLEMENT_MEM
+
 #include "f_mem.v.h"
 #include <faur.v.h>
 
 #if F_CONFIG_DEBUG_ALLOC
 size_t f_mem__tally, f_mem__top;
+unsigned f_mem__allocsFrame; // Allocations during the last frame
+
+static unsigned g_allocs; // Allocations during this frame so far
+
+#if F_CONFIG_DEBUG_ALLOC_SITES
+#define F__SITES_NUM 256
+
+typedef struct {
+    const char* file; // __FILE__ of the call, NULL for untagged calls
+    int line; // __LINE__ of the call
+    unsigned allocs; // Allocations since start
+    unsigned allocsFrame; // Allocations during the last frame
+    unsigned allocsNow; // Allocations during this frame so far
+    size_t bytes; // Bytes requested since start
+} FMemSite;
+
+static FMemSite g_sites[F__SITES_NUM];
+static const char* g_siteFile;
+static int g_siteLine;
+
+void f_mem__siteSet(const char* File, int Line)
+{
+    g_siteFile = File;
+    g_siteLine = Line;
+}
+
+static void siteAdd(size_t Size)
+{
+    uintptr_t hash = ((uintptr_t)g_siteFile >> 3) * 31 + (uintptr_t)g_siteLine;
+    FMemSite* site = NULL;
+
+    for(unsigned i = 0; i < F__SITES_NUM; i++) {
+        FMemSite* s = &g_sites[(hash + i) % F__SITES_NUM];
+
+        if(s->allocs == 0) {
+            s->file = g_siteFile;
+            s->line = g_siteLine;
+        }
+
+        if(s->file == g_siteFile && s->line == g_siteLine) {
+            site = s;
+
+            break;
+        }
+    }
+
+    if(site != NULL) {
+        site->allocs++;
+        site->allocsNow++;
+        site->bytes += Size;
+    }
+
+    // Consumed, so calls from inside f_mem do not inherit it
+    g_siteFile = NULL;
+    g_siteLine = 0;
+}
+#endif
 
 static inline void tallyAdd(size_t Size)
 {
     f_mem__tally += Size;
     f_mem__top = f_math_maxz(f_mem__top, f_mem__tally);
+
+    g_allocs++;
+
+    #if F_CONFIG_DEBUG_ALLOC_SITES
+        siteAdd(Size);
+    #endif
+}
+
+void f_mem__frame(void)
+{
+    f_mem__allocsFrame = g_allocs;
+    g_allocs = 0;
+
+    #if F_CONFIG_DEBUG_ALLOC_SITES
+        for(unsigned i = F__SITES_NUM; i--; ) {
+            g_sites[i].allocsFrame = g_sites[i].allocsNow;
+            g_sites[i].allocsNow = 0;
+        }
+    #endif
 }
 #endif
 
@@ -140,3 +218,50 @@ void f_mem_freea(void* Buffer)
 
     f_mem_free(*((void**)Buffer - 1));
 }
+
+bool f_mem_statsWrite(const char* Path)
+{
+    #if F_CONFIG_DEBUG_ALLOC
+        FFile* f = f_file_new(Path, F_FILE_WRITE);
+
+        if(f == NULL) {
+            return false;
+        }
+
+        f_file_writef(f,
+                      "%zu bytes now, %zu top, %u allocs last frame\n",
+                      f_mem__tally,
+                      f_mem__top,
+                      f_mem__allocsFrame);
+
+        f_pool__statsWrite(f);
+
+        #if F_CONFIG_DEBUG_ALLOC_SITES
+            f_file_writef(f, "\nsite allocs bytes allocs/frame\n");
+
+            for(unsigned i = 0; i < F__SITES_NUM; i++) {
+                const FMemSite* s = &g_sites[i];
+
+                if(s->allocs > 0) {
+                    f_file_writef(f,
+                                  "%s:%d %u %zu %u\n",
+                                  s->file ? s->file : "(untagged)",
+                                  s->line,
+                                  s->allocs,
+                                  s->bytes,
+                                  s->allocsFrame);
+                }
+            }
+        #endif
+
+        f_file_free(f);
+
+        return true;
+    #else
+        F_UNUSED(Path);
+
+        f_out__warning("f_mem_statsWrite: Needs F_CONFIG_DEBUG_ALLOC");
+
+        return false;
+    #endif
+}
@@ -27,4 +27,21 @@ extern void* f_mem_dup(const void* Buffer, size_t Size);
 extern void f_mem_free(void* Buffer);
 extern void f_mem_freea(void* Buffer);
 
+extern bool f_mem_statsWrite(const char* Path);
+
+#if F_CONFIG_DEBUG_ALLOC_SITES
+    extern void f_mem__siteSet(const char* File, int Line);
+
+    #ifndef FAUR_IMPLEMENT_MEM
+        #define f_mem_malloc(Size) \
+            (f_mem__siteSet(__FILE__, __LINE__), f_mem_malloc(Size))
+        #define f_mem_mallocz(Size) \
+            (f_mem__siteSet(__FILE__, __LINE__), f_mem_mallocz(Size))
+        #define f_mem_malloca(Size, AlignExp) \
+            (f_mem__siteSet(__FILE__, __LINE__), f_mem_malloca(Size, AlignExp))
+        #define f_mem_dup(Buffer, Size) \
+            (f_mem__siteSet(__FILE__, __LINE__), f_mem_dup(Buffer, Size))
+    #endif
+#endif
+
 #endif // F_INC_MEMORY_MEM_P_H
@@ -29,5 +29,10 @@ typedef union {
 } FMaxMemAlignType;
 
 extern size_t f_mem__tally, f_mem__top;
+extern unsigned f_mem__allocsFrame;
+
+#if F_CONFIG_DEBUG_ALLOC
+    extern void f_mem__frame(void);
+#endif
 
 #endif // F_INC_MEMORY_MEM_V_H
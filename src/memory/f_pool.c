@@ -26,32 +26,138 @@
     #define F__ENTRIES_NUM_MAX 1024
 #endif
 
+#define F__THREADS (F_CONFIG_LIB_SDL == 2 && F_CONFIG_LIB_SDL_THREADS)
+
+#if F__THREADS
+    // Thread-safe pools that get a per-thread cache, others share a lock
+    #define F__CACHES_NUM 16
+
+    // Entries moved between a thread cache and its pool at a time
+    #define F__CACHE_BATCH 32
+
+    #define F__CACHE_NONE UINT_MAX
+
+    // Spins on a taken lock before yielding, in case its holder was preempted
+    #define F__LOCK_SPINS 64
+#endif
+
 typedef union FPoolEntryHeader FPoolEntryHeader;
 typedef struct FPoolSlab FPoolSlab;
 
 union FPoolEntryHeader {
-    FPoolEntryHeader* nextFreeEntry; // Next free entry in a slab
-    FPool* parentPool; // Pool this active entry belongs to
+    struct {
+        FPoolEntryHeader* nextFreeEntry; // Next free entry in a free list
+        FPoolSlab* parentSlab; // Slab this entry is in, set for all entries
+    } links;
     FMaxMemAlignType alignment; // Used to prompt max alignment padding
 };
 
 struct FPoolSlab {
     FPoolSlab* nextSlab; // Next slab in a pool's slab list
+    FPool* parentPool; // Pool this slab belongs to
+    unsigned numEntries; // Number of entries in buffer
+    unsigned numEntriesLive; // Entries not on the pool's free list
+    unsigned numEntriesCarved; // Entries handed out at least once
     FPoolEntryHeader buffer[]; // Memory space for objects
 };
 
 struct FPool {
+    FListIntrNode listNode; // In g_poolList
     unsigned objSize; // Size of a user object within a pool entry
     unsigned entrySize; // Size of each pool entry in a slab
     unsigned numEntriesPerSlab; // Grows with usage
-    FPoolSlab* slabList; // Keeps track of all allocated slabs
+    FPoolSlab* slabList; // Newest slab first, only it is partly carved
     FPoolEntryHeader* freeEntryList; // Head of the free pool entries list
+    #if F__THREADS
+        bool threadSafe; // Any thread may alloc and release
+        unsigned cacheIndex; // Slot in each thread's g_caches, or NONE
+        unsigned serial; // Tells this pool apart from freed ones
+        volatile int lock; // Guards slabList and freeEntryList
+    #endif
+    #if F_CONFIG_DEBUG_ALLOC
+        FPoolStats stats; // Live objects, slabs and allocations per frame
+    #endif
+};
+
+#if F__THREADS
+typedef struct {
+    unsigned serial; // Serial of the pool that owns these entries
+    unsigned freeEntriesNum; // Length of freeEntryList
+    FPoolEntryHeader* freeEntryList; // Entries this thread can use unlocked
+} FPoolCache;
+
+static __thread FPoolCache g_caches[F__CACHES_NUM];
+static FPool* g_cachesOwner[F__CACHES_NUM]; // Pool using each g_caches slot
+static unsigned g_serial;
+static volatile int g_lock; // Guards g_cachesOwner
+
+static inline void lockGet(volatile int* Lock)
+{
+    while(__sync_lock_test_and_set(Lock, 1)) {
+        for(unsigned spins = 0; *Lock; spins++) {
+            if(spins < F__LOCK_SPINS) {
+                #if defined(__i386__) || defined(__x86_64__)
+                    __builtin_ia32_pause();
+                #endif
+            } else {
+                f_time_msWait(0);
+            }
+        }
+    }
+}
+
+static inline void lockRelease(volatile int* Lock)
+{
+    __sync_lock_release(Lock);
+}
+#endif
+
+#if F_CONFIG_DEBUG_ALLOC
+static inline unsigned statAdd(const FPool* Pool, unsigned* Counter, int Add)
+{
+    #if F__THREADS
+        if(Pool->threadSafe) {
+            return __sync_add_and_fetch(Counter, (unsigned)Add);
+        }
+    #else
+        F_UNUSED(Pool);
+    #endif
+
+    return *Counter += (unsigned)Add;
+}
+
+static inline void statMax(const FPool* Pool, unsigned* Counter, unsigned Value)
+{
+    #if F__THREADS
+        if(Pool->threadSafe) {
+            unsigned old;
+
+            do {
+                old = __sync_fetch_and_add(Counter, 0);
+            } while(old < Value
+                        && !__sync_bool_compare_and_swap(Counter, old, Value));
+
+            return;
+        }
+    #else
+        F_UNUSED(Pool);
+    #endif
+
+    if(*Counter < Value) {
+        *Counter = Value;
+    }
+}
+#endif
+
+static const bool g_threadSafe[F_POOL__NUM] = {
+    [F_POOL__LIST] = true,
+    [F_POOL__LISTNODE] = true,
 };
 
 static const unsigned g_sizes[F_POOL__NUM] = {
+    [F_POOL__ARRAY] = sizeof(FArray),
     [F_POOL__BLOCK] = sizeof(FBlock),
     [F_POOL__CONSOLE] = sizeof(FConsoleLine),
-    [F_POOL__HASHENTRY] = sizeof(F__HashEntry),
     [F_POOL__LIST] = sizeof(FList),
     [F_POOL__LISTINTR] = sizeof(FListIntr),
     [F_POOL__LISTNODE] = sizeof(FListNode),
@@ -67,12 +173,36 @@ static const unsigned g_sizes[F_POOL__NUM] = {
     [F_POOL__TIMER] = sizeof(FTimer),
 };
 
+#if F_CONFIG_DEBUG_ALLOC
+static const char* g_names[F_POOL__NUM] = {
+    [F_POOL__ARRAY] = "Array",
+    [F_POOL__BLOCK] = "Block",
+    [F_POOL__CONSOLE] = "Console",
+    [F_POOL__LIST] = "List",
+    [F_POOL__LISTINTR] = "ListIntr",
+    [F_POOL__LISTNODE] = "ListNode",
+    [F_POOL__PATH] = "Path",
+    [F_POOL__SAMPLE] = "Sample",
+    [F_POOL__SPRITE] = "Sprite",
+    [F_POOL__SPRITE_LAYER] = "SpriteLayer",
+    [F_POOL__STACK_ALIGN] = "StackAlign",
+    [F_POOL__STACK_COLOR] = "StackColor",
+    [F_POOL__STACK_FONT] = "StackFont",
+    [F_POOL__STACK_SCREEN] = "StackScreen",
+    [F_POOL__STACK_STATE] = "StackState",
+    [F_POOL__TIMER] = "Timer",
+};
+#endif
+
 static FPool* g_pools[F_POOL__NUM];
+static F_LISTINTR(g_poolList, FPool, listNode);
 
 static void f_pool__init(void)
 {
     for(int p = F_POOL__NUM; p--; ) {
-        g_pools[p] = f_pool_new(g_sizes[p]);
+        g_pools[p] = g_threadSafe[p]
+                        ? f_pool_newThreadSafe(g_sizes[p])
+                        : f_pool_new(g_sizes[p]);
     }
 }
 
@@ -91,27 +221,20 @@ const FPack f_pack__pool = {
 
 static void slab_new(FPool* Pool)
 {
+    // Zeroed up front, so entries carved from it need no memset
     FPoolSlab* s =
-        f_mem_malloc(
+        f_mem_mallocz(
             sizeof(FPoolSlab) + Pool->entrySize * Pool->numEntriesPerSlab);
 
     s->nextSlab = Pool->slabList;
+    s->parentPool = Pool;
+    s->numEntries = Pool->numEntriesPerSlab;
 
-    Pool->slabList = s;
-    Pool->freeEntryList = s->buffer;
-
-    FPoolEntryHeader* entry;
-    FPoolEntryHeader* lastEntry = s->buffer;
-
-    for(unsigned e = 1; e < Pool->numEntriesPerSlab; e++) {
-        entry = (FPoolEntryHeader*)((uintptr_t)s->buffer + e * Pool->entrySize);
-
-        lastEntry->nextFreeEntry = entry;
-        lastEntry = entry;
-    }
-
-    lastEntry->nextFreeEntry = NULL;
+    #if F_CONFIG_DEBUG_ALLOC
+        Pool->stats.slabs++;
+    #endif
 
+    Pool->slabList = s;
     Pool->numEntriesPerSlab =
         f_math_minu(Pool->numEntriesPerSlab * 2, F__ENTRIES_NUM_MAX);
 }
@@ -126,6 +249,37 @@ FPool* f_pool_new(size_t Size)
                                         & ~(sizeof(FMaxMemAlignType) - 1)));
     p->numEntriesPerSlab = F__ENTRIES_NUM_START;
 
+    f_listintr_addLast(&g_poolList, p);
+
+    #if F__THREADS
+        p->cacheIndex = F__CACHE_NONE;
+    #endif
+
+    return p;
+}
+
+FPool* f_pool_newThreadSafe(size_t Size)
+{
+    FPool* p = f_pool_new(Size);
+
+    #if F__THREADS
+        p->threadSafe = true;
+        p->serial = (unsigned)__sync_add_and_fetch(&g_serial, 1);
+
+        lockGet(&g_lock);
+
+        for(unsigned c = 0; c < F__CACHES_NUM; c++) {
+            if(g_cachesOwner[c] == NULL) {
+                g_cachesOwner[c] = p;
+                p->cacheIndex = c;
+
+                break;
+            }
+        }
+
+        lockRelease(&g_lock);
+    #endif
+
     return p;
 }
 
@@ -135,6 +289,19 @@ void f_pool_free(FPool* Pool)
         return;
     }
 
+    #if F__THREADS
+        if(Pool->cacheIndex != F__CACHE_NONE) {
+            // Other threads drop their stale caches on the serial mismatch
+            g_caches[Pool->cacheIndex].serial = 0;
+
+            lockGet(&g_lock);
+            g_cachesOwner[Pool->cacheIndex] = NULL;
+            lockRelease(&g_lock);
+        }
+    #endif
+
+    f_listintr_removeItem(&g_poolList, Pool);
+
     for(FPoolSlab* slab = Pool->slabList; slab != NULL; ) {
         FPoolSlab* nextSlab = slab->nextSlab;
 
@@ -146,24 +313,197 @@ void f_pool_free(FPool* Pool)
     f_mem_free(Pool);
 }
 
-void* f_pool_alloc(FPool* Pool)
+static FPoolEntryHeader* entryTake(FPool* Pool, bool* Zeroed)
 {
-    if(Pool->freeEntryList == NULL) {
-        slab_new(Pool);
+    FPoolEntryHeader* entry = Pool->freeEntryList;
+
+    if(entry != NULL) {
+        Pool->freeEntryList = entry->links.nextFreeEntry;
+        *Zeroed = false;
+    } else {
+        FPoolSlab* s = Pool->slabList;
+
+        if(s == NULL || s->numEntriesCarved == s->numEntries) {
+            slab_new(Pool);
+            s = Pool->slabList;
+        }
+
+        entry = (FPoolEntryHeader*)
+                    ((uintptr_t)s->buffer
+                        + s->numEntriesCarved++ * Pool->entrySize);
+        entry->links.parentSlab = s;
+        *Zeroed = true;
     }
 
-    FPoolEntryHeader* entry = Pool->freeEntryList;
+    entry->links.parentSlab->numEntriesLive++;
+
+    return entry;
+}
+
+static void entryGive(FPool* Pool, FPoolEntryHeader* Entry)
+{
+    Entry->links.parentSlab->numEntriesLive--;
+    Entry->links.nextFreeEntry = Pool->freeEntryList;
+    Pool->freeEntryList = Entry;
+}
+
+#if F__THREADS
+static FPoolCache* cacheGet(const FPool* Pool)
+{
+    if(Pool->cacheIndex == F__CACHE_NONE) {
+        return NULL;
+    }
+
+    FPoolCache* cache = &g_caches[Pool->cacheIndex];
+
+    if(cache->serial != Pool->serial) {
+        // Left over from a freed pool, its entries went with its slabs
+        cache->serial = Pool->serial;
+        cache->freeEntriesNum = 0;
+        cache->freeEntryList = NULL;
+    }
+
+    return cache;
+}
+
+static FPoolEntryHeader* entryTakeThreadSafe(FPool* Pool, bool* Zeroed)
+{
+    FPoolEntryHeader* entry;
+    FPoolCache* cache = cacheGet(Pool);
+
+    if(cache != NULL && cache->freeEntryList != NULL) {
+        entry = cache->freeEntryList;
+
+        cache->freeEntryList = entry->links.nextFreeEntry;
+        cache->freeEntriesNum--;
+        *Zeroed = false;
+
+        return entry;
+    }
+
+    lockGet(&Pool->lock);
+
+    entry = entryTake(Pool, Zeroed);
+
+    if(cache != NULL) {
+        bool zeroed;
+
+        // The cache list overwrites these entries' links, they count as used
+        for(unsigned e = F__CACHE_BATCH; e--; ) {
+            FPoolEntryHeader* extra = entryTake(Pool, &zeroed);
+
+            extra->links.nextFreeEntry = cache->freeEntryList;
+            cache->freeEntryList = extra;
+        }
+
+        cache->freeEntriesNum = F__CACHE_BATCH;
+    }
+
+    lockRelease(&Pool->lock);
+
+    return entry;
+}
+
+static void entryGiveThreadSafe(FPool* Pool, FPoolEntryHeader* Entry)
+{
+    FPoolCache* cache = cacheGet(Pool);
+
+    if(cache != NULL) {
+        Entry->links.nextFreeEntry = cache->freeEntryList;
+        cache->freeEntryList = Entry;
+
+        if(++cache->freeEntriesNum < 2 * F__CACHE_BATCH) {
+            return;
+        }
+
+        lockGet(&Pool->lock);
+
+        for(unsigned e = F__CACHE_BATCH; e--; ) {
+            FPoolEntryHeader* extra = cache->freeEntryList;
+
+            cache->freeEntryList = extra->links.nextFreeEntry;
+            entryGive(Pool, extra);
+        }
+
+        cache->freeEntriesNum -= F__CACHE_BATCH;
+
+        lockRelease(&Pool->lock);
+    } else {
+        lockGet(&Pool->lock);
+        entryGive(Pool, Entry);
+        lockRelease(&Pool->lock);
+    }
+}
+
+void f_pool__threadEnd(void)
+{
+    // Holding g_lock keeps the owner pools from being freed meanwhile
+    lockGet(&g_lock);
+
+    for(unsigned c = F__CACHES_NUM; c--; ) {
+        FPoolCache* cache = &g_caches[c];
+        FPool* pool = g_cachesOwner[c];
+
+        if(pool != NULL && cache->serial == pool->serial) {
+            lockGet(&pool->lock);
+
+            while(cache->freeEntryList != NULL) {
+                FPoolEntryHeader* entry = cache->freeEntryList;
+
+                cache->freeEntryList = entry->links.nextFreeEntry;
+                entryGive(pool, entry);
+            }
 
-    Pool->freeEntryList = entry->nextFreeEntry;
-    entry->parentPool = Pool;
+            lockRelease(&pool->lock);
+        }
+
+        cache->serial = 0;
+        cache->freeEntriesNum = 0;
+        cache->freeEntryList = NULL;
+    }
+
+    lockRelease(&g_lock);
+}
+#endif
+
+static inline void* entryAlloc(FPool* Pool, bool Zero)
+{
+    bool zeroed;
+
+    #if F__THREADS
+        FPoolEntryHeader* entry = Pool->threadSafe
+                                    ? entryTakeThreadSafe(Pool, &zeroed)
+                                    : entryTake(Pool, &zeroed);
+    #else
+        FPoolEntryHeader* entry = entryTake(Pool, &zeroed);
+    #endif
+
+    #if F_CONFIG_DEBUG_ALLOC
+        statMax(Pool,
+                &Pool->stats.objectsTop,
+                statAdd(Pool, &Pool->stats.objectsLive, 1));
+        statAdd(Pool, &Pool->stats.allocsNow, 1);
+    #endif
 
     void* userBuffer = entry + 1;
 
-    memset(userBuffer, 0, Pool->objSize);
+    if(Zero && !zeroed) {
+        memset(userBuffer, 0, Pool->objSize);
+    }
 
     return userBuffer;
 }
 
+void* f_pool_alloc(FPool* Pool)
+{
+    return entryAlloc(Pool, true);
+}
+
+void* f_pool_allocRaw(FPool* Pool)
+{
+    return entryAlloc(Pool, false);
+}
+
 void f_pool_release(void* Buffer)
 {
     if(Buffer == NULL) {
@@ -171,10 +511,101 @@ void f_pool_release(void* Buffer)
     }
 
     FPoolEntryHeader* entry = (FPoolEntryHeader*)Buffer - 1;
-    FPool* pool = entry->parentPool;
+    FPool* pool = entry->links.parentSlab->parentPool;
+
+    #if F_CONFIG_DEBUG_ALLOC
+        statAdd(pool, &pool->stats.objectsLive, -1);
+    #endif
+
+    #if F__THREADS
+        if(pool->threadSafe) {
+            entryGiveThreadSafe(pool, entry);
+
+            return;
+        }
+    #endif
+
+    entryGive(pool, entry);
+}
 
-    entry->nextFreeEntry = pool->freeEntryList;
-    pool->freeEntryList = entry;
+size_t f_pool_trim(FPool* Pool)
+{
+    size_t freed = 0;
+
+    #if F__THREADS
+        if(Pool->threadSafe) {
+            lockGet(&Pool->lock);
+        }
+    #endif
+
+    bool found = false;
+
+    for(FPoolSlab* s = Pool->slabList; s != NULL; s = s->nextSlab) {
+        if(s->numEntriesLive == 0) {
+            found = true;
+
+            break;
+        }
+    }
+
+    if(found) {
+        // Unlink the empty slabs' entries from the free list first
+        FPoolEntryHeader** link = &Pool->freeEntryList;
+
+        while(*link != NULL) {
+            FPoolEntryHeader* entry = *link;
+
+            if(entry->links.parentSlab->numEntriesLive == 0) {
+                *link = entry->links.nextFreeEntry;
+            } else {
+                link = &entry->links.nextFreeEntry;
+            }
+        }
+
+        for(FPoolSlab** link = &Pool->slabList; *link != NULL; ) {
+            FPoolSlab* s = *link;
+
+            if(s->numEntriesLive == 0) {
+                *link = s->nextSlab;
+                freed += sizeof(FPoolSlab) + Pool->entrySize * s->numEntries;
+
+                f_mem_free(s);
+
+                #if F_CONFIG_DEBUG_ALLOC
+                    Pool->stats.slabs--;
+                #endif
+            } else {
+                link = &s->nextSlab;
+            }
+        }
+
+        if(Pool->slabList == NULL) {
+            Pool->numEntriesPerSlab = F__ENTRIES_NUM_START;
+        }
+    }
+
+    #if F__THREADS
+        if(Pool->threadSafe) {
+            lockRelease(&Pool->lock);
+        }
+    #endif
+
+    return freed;
+}
+
+void f_pool__trimAll(void)
+{
+    size_t freed = 0;
+
+    F_LISTINTR_ITERATE(&g_poolList, FPool*, p) {
+        freed += f_pool_trim(p);
+    }
+
+    #if F_CONFIG_DEBUG
+        if(freed > 0) {
+            f_out__info("Trimmed %zu bytes from pools", freed);
+        }
+    #endif
 }
 
 void* f_pool__alloc(FPoolId Pool)
@@ -182,11 +613,62 @@ void* f_pool__alloc(FPoolId Pool)
     return f_pool_alloc(g_pools[Pool]);
 }
 
+void* f_pool__allocRaw(FPoolId Pool)
+{
+    return f_pool_allocRaw(g_pools[Pool]);
+}
+
 void* f_pool__dup(FPoolId Pool, const void* Buffer)
 {
-    void* copy = f_pool__alloc(Pool);
+    void* copy = f_pool__allocRaw(Pool);
 
     memcpy(copy, Buffer, g_sizes[Pool]);
 
     return copy;
 }
+
+#if F_CONFIG_DEBUG_ALLOC
+void f_pool__frame(void)
+{
+    F_LISTINTR_ITERATE(&g_poolList, FPool*, p) {
+        p->stats.allocsFrame = p->stats.allocsNow;
+        p->stats.allocsNow = 0;
+    }
+}
+
+const FPoolStats* f_pool__statsGet(FPoolId Pool)
+{
+    return &g_pools[Pool]->stats;
+}
+
+const char* f_pool__nameGet(FPoolId Pool)
+{
+    return g_names[Pool];
+}
+
+void f_pool__statsWrite(FFile* File)
+{
+    f_file_writef(File, "\npool live top slabs allocs/frame\n");
+
+    F_LISTINTR_ITERATE(&g_poolList, FPool*, p) {
+        const char* name = "(custom)";
+
+        for(int i = F_POOL__NUM; i--; ) {
+            if(g_pools[i] == p) {
+                name = g_names[i];
+
+                break;
+            }
+        }
+
+        f_file_writef(File,
+                      "%s(%u) %u %u %u %u\n",
+                      name,
+                      p->objSize,
+                      p->stats.objectsLive,
+                      p->stats.objectsTop,
+                      p->stats.slabs,
+                      p->stats.allocsFrame);
+    }
+}
+#endif
@@ -23,9 +23,13 @@
 typedef struct FPool FPool;
 
 extern FPool* f_pool_new(size_t Size);
+extern FPool* f_pool_newThreadSafe(size_t Size);
 extern void f_pool_free(FPool* Pool);
 
 extern void* f_pool_alloc(FPool* Pool);
+extern void* f_pool_allocRaw(FPool* Pool);
 extern void f_pool_release(void* Buffer);
 
+extern size_t f_pool_trim(FPool* Pool);
+
 #endif // F_INC_MEMORY_POOL_P_H
@@ -22,9 +22,9 @@
 
 typedef enum {
     F_POOL__INVALID = -1,
+    F_POOL__ARRAY,
     F_POOL__BLOCK,
     F_POOL__CONSOLE,
-    F_POOL__HASHENTRY,
     F_POOL__LIST,
     F_POOL__LISTINTR,
     F_POOL__LISTNODE,
@@ -41,11 +41,32 @@ typedef enum {
     F_POOL__NUM
 } FPoolId;
 
+typedef struct {
+    unsigned objectsLive; // Objects handed out and not released yet
+    unsigned objectsTop; // Highest objectsLive so far
+    unsigned slabs; // Slabs currently allocated
+    unsigned allocsFrame; // f_pool_alloc calls during the last frame
+    unsigned allocsNow; // f_pool_alloc calls during this frame so far
+} FPoolStats;
+
+#include "../files/f_file.v.h"
 #include "../general/f_init.v.h"
 
 extern const FPack f_pack__pool;
 
 extern void* f_pool__alloc(FPoolId Pool);
+extern void* f_pool__allocRaw(FPoolId Pool);
 extern void* f_pool__dup(FPoolId Pool, const void* Buffer);
 
+extern void f_pool__trimAll(void);
+extern void f_pool__threadEnd(void);
+
+#if F_CONFIG_DEBUG_ALLOC
+    extern void f_pool__frame(void);
+
+    extern const FPoolStats* f_pool__statsGet(FPoolId Pool);
+    extern const char* f_pool__nameGet(FPoolId Pool);
+    extern void f_pool__statsWrite(FFile* File);
+#endif
+
 #endif // F_INC_MEMORY_POOL_V_H
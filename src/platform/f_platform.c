@@ -90,6 +90,20 @@ static void f_platform__uninit(void)
     #endif
 }
 
+#if !(F_CONFIG_LIB_SDL == 2 && F_CONFIG_LIB_SDL_THREADS)
+unsigned f_platform_api__taskWorkersGet(void)
+{
+    return 0;
+}
+
+void f_platform_api__taskRun(FCallPlatformTask* Task, void* Context, unsigned Num)
+{
+    for(unsigned i = 0; i < Num; i++) {
+        Task(Context, i);
+    }
+}
+#endif
+
 const FPack f_pack__platform = {
     "Platform",
     f_platform__init,
@@ -32,6 +32,8 @@ typedef void FPlatformTextureScreen;
 
 typedef void FPlatformFile;
 
+typedef void FCallPlatformTask(void* Context, unsigned Index);
+
 #include "../files/f_file.v.h"
 #include "../files/f_path.v.h"
 #include "../general/f_main.v.h"
@@ -45,8 +47,12 @@ extern const FPack f_pack__platform;
 extern void f_platform_api__customExit(int Status);
 
 extern uint32_t f_platform_api__timeMsGet(void);
+extern uint32_t f_platform_api__timeUsGet(void);
 extern void f_platform_api__timeMsWait(uint32_t Ms);
 
+extern unsigned f_platform_api__taskWorkersGet(void);
+extern void f_platform_api__taskRun(FCallPlatformTask* Task, void* Context, unsigned Num);
+
 extern void f_platform_api__screenInit(void);
 extern void f_platform_api__screenUninit(void);
 extern void f_platform_api__screenClear(void);
@@ -57,6 +57,11 @@ uint32_t f_platform_api__timeMsGet(void)
     return millis();
 }
 
+uint32_t f_platform_api__timeUsGet(void)
+{
+    return micros();
+}
+
 void f_platform_api__timeMsWait(uint32_t Ms)
 {
     f_time_msSpin(Ms);
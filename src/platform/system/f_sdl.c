@@ -27,6 +27,102 @@
 
 static uint32_t g_sdlFlags;
 
+#if F_CONFIG_LIB_SDL == 2 && F_CONFIG_LIB_SDL_THREADS
+    #define F__TASK_WORKERS_MAX 15
+
+    static struct {
+        SDL_mutex* mutex;
+        SDL_cond* wake; // workers sleep on this until a batch is posted
+        SDL_cond* done; // caller sleeps on this until the batch is finished
+        SDL_Thread* threads[F__TASK_WORKERS_MAX];
+        unsigned threadsNum;
+        FCallPlatformTask* task;
+        void* context;
+        unsigned next; // next task index to hand out
+        unsigned num; // number of tasks in current batch
+        unsigned finished; // tasks completed in current batch
+        bool quit;
+    } g_tasks;
+
+    static int taskWorker(void* Data)
+    {
+        F_UNUSED(Data);
+
+        SDL_LockMutex(g_tasks.mutex);
+
+        for(;;) {
+            while(!g_tasks.quit && g_tasks.next >= g_tasks.num) {
+                SDL_CondWait(g_tasks.wake, g_tasks.mutex);
+            }
+
+            if(g_tasks.quit) {
+                break;
+            }
+
+            unsigned index = g_tasks.next++;
+
+            SDL_UnlockMutex(g_tasks.mutex);
+            g_tasks.task(g_tasks.context, index);
+            SDL_LockMutex(g_tasks.mutex);
+
+            if(++g_tasks.finished == g_tasks.num) {
+                SDL_CondSignal(g_tasks.done);
+            }
+        }
+
+        SDL_UnlockMutex(g_tasks.mutex);
+
+        // Entries cached by this thread would be lost with it
+        f_pool__threadEnd();
+
+        return 0;
+    }
+
+    static void tasksInit(void)
+    {
+        g_tasks.mutex = SDL_CreateMutex();
+        g_tasks.wake = SDL_CreateCond();
+        g_tasks.done = SDL_CreateCond();
+
+        if(!g_tasks.mutex || !g_tasks.wake || !g_tasks.done) {
+            F__FATAL("SDL_CreateMutex/Cond: %s", SDL_GetError());
+        }
+
+        int cpus = SDL_GetCPUCount();
+        unsigned workers = cpus > 1 ? (unsigned)cpus - 1 : 0;
+
+        for(unsigned t = f_math_minu(workers, F__TASK_WORKERS_MAX); t--; ) {
+            SDL_Thread* thread = SDL_CreateThread(taskWorker, "FTask", NULL);
+
+            if(thread == NULL) {
+                f_out__error("SDL_CreateThread: %s", SDL_GetError());
+
+                break;
+            }
+
+            g_tasks.threads[g_tasks.threadsNum++] = thread;
+        }
+
+        f_out__info("Using %u task worker threads", g_tasks.threadsNum);
+    }
+
+    static void tasksUninit(void)
+    {
+        SDL_LockMutex(g_tasks.mutex);
+        g_tasks.quit = true;
+        SDL_CondBroadcast(g_tasks.wake);
+        SDL_UnlockMutex(g_tasks.mutex);
+
+        for(unsigned t = g_tasks.threadsNum; t--; ) {
+            SDL_WaitThread(g_tasks.threads[t], NULL);
+        }
+
+        SDL_DestroyCond(g_tasks.done);
+        SDL_DestroyCond(g_tasks.wake);
+        SDL_DestroyMutex(g_tasks.mutex);
+    }
+#endif
+
 void f_platform_sdl__init(void)
 {
     SDL_version cv, rv;
@@ -54,6 +150,10 @@ void f_platform_sdl__init(void)
     f_platform_sdl_input__init();
     f_platform_sdl_video__init();
 
+    #if F_CONFIG_LIB_SDL == 2 && F_CONFIG_LIB_SDL_THREADS
+        tasksInit();
+    #endif
+
     #if F_CONFIG_SOUND_ENABLED
         f_platform_sdl_sound__init();
     #endif
@@ -61,6 +161,10 @@ void f_platform_sdl__init(void)
 
 void f_platform_sdl__uninit(void)
 {
+    #if F_CONFIG_LIB_SDL == 2 && F_CONFIG_LIB_SDL_THREADS
+        tasksUninit();
+    #endif
+
     f_platform_sdl_input__uninit();
     f_platform_sdl_video__uninit();
 
@@ -78,6 +182,24 @@ uint32_t f_platform_api__timeMsGet(void)
     return SDL_GetTicks();
 }
 
+uint32_t f_platform_api__timeUsGet(void)
+{
+    #if F_CONFIG_LIB_SDL == 1
+        return SDL_GetTicks() * 1000;
+    #elif F_CONFIG_LIB_SDL == 2
+        static uint64_t freq;
+
+        if(freq == 0) {
+            freq = SDL_GetPerformanceFrequency();
+        }
+
+        uint64_t count = SDL_GetPerformanceCounter();
+
+        return (uint32_t)(count / freq * 1000000
+                            + count % freq * 1000000 / freq);
+    #endif
+}
+
 void f_platform_api__timeMsWait(uint32_t Ms)
 {
     #if F_CONFIG_TRAIT_NO_SLEEP
@@ -98,4 +220,52 @@ void f_platform_api__timeMsWait(uint32_t Ms)
     #endif
 }
 #endif
+
+#if F_CONFIG_LIB_SDL == 2 && F_CONFIG_LIB_SDL_THREADS
+unsigned f_platform_api__taskWorkersGet(void)
+{
+    return g_tasks.threadsNum;
+}
+
+void f_platform_api__taskRun(FCallPlatformTask* Task, void* Context, unsigned Num)
+{
+    if(g_tasks.threadsNum == 0 || Num < 2) {
+        for(unsigned i = 0; i < Num; i++) {
+            Task(Context, i);
+        }
+
+        return;
+    }
+
+    SDL_LockMutex(g_tasks.mutex);
+
+    g_tasks.task = Task;
+    g_tasks.context = Context;
+    g_tasks.next = 0;
+    g_tasks.num = Num;
+    g_tasks.finished = 0;
+
+    SDL_CondBroadcast(g_tasks.wake);
+
+    // The calling thread works on the batch too
+    while(g_tasks.next < g_tasks.num) {
+        unsigned index = g_tasks.next++;
+
+        SDL_UnlockMutex(g_tasks.mutex);
+        Task(Context, index);
+        SDL_LockMutex(g_tasks.mutex);
+
+        g_tasks.finished++;
+    }
+
+    while(g_tasks.finished < g_tasks.num) {
+        SDL_CondWait(g_tasks.done, g_tasks.mutex);
+    }
+
+    g_tasks.next = 0;
+    g_tasks.num = 0;
+
+    SDL_UnlockMutex(g_tasks.mutex);
+}
+#endif
 #endif // F_CONFIG_LIB_SDL
@@ -139,6 +139,14 @@ uint32_t f_platform_api__timeMsGet(void)
     return TIMER_REG(0) / 1000;
 }
 
+uint32_t f_platform_api__timeUsGet(void)
+{
+    unsigned div = TIMER_REG(0x08) & 3;
+    TIMER_REG(0x08) = 0x48 | div; // Run timer, latch value
+
+    return TIMER_REG(0);
+}
+
 void f_platform_api__timeMsWait(uint32_t Ms)
 {
     f_time_msSpin(Ms);
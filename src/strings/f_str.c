@@ -84,6 +84,38 @@ char* f_str_dup(const char* String)
     return strcpy(buffer, String);
 }
 
+char* f_str_dupFrame(const char* String)
+{
+    if(String == NULL) {
+        return NULL;
+    }
+
+    char* buffer = f_arena_frameAlloc(strlen(String) + 1);
+
+    return strcpy(buffer, String);
+}
+
+char* f_str_fmtFrame(const char* Format, ...)
+{
+    va_list args;
+
+    va_start(args, Format);
+    int len = vsnprintf(NULL, 0, Format, args);
+    va_end(args);
+
+    if(len < 0) {
+        return NULL;
+    }
+
+    char* buffer = f_arena_frameAlloc((size_t)len + 1);
+
+    va_start(args, Format);
+    vsnprintf(buffer, (size_t)len + 1, Format, args);
+    va_end(args);
+
+    return buffer;
+}
+
 char* f_str_trim(const char* String)
 {
     int start = 0;
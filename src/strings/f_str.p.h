@@ -27,6 +27,8 @@ extern bool f_str_fmtv(char* Buffer, size_t Size, bool OverflowOk, const char* F
 
 extern char* f_str_merge(const char* String1, ...) F__ATTRIBUTE_FORMAT(1);
 extern char* f_str_dup(const char* String);
+extern char* f_str_dupFrame(const char* String);
+extern char* f_str_fmtFrame(const char* Format, ...) F__ATTRIBUTE_FORMAT(1);
 extern char* f_str_trim(const char* String);
 
 extern char* f_str_subGetRange(const char* String, int Start, int End);
@@ -0,0 +1,61 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "f_strid.v.h"
+#include <faur.v.h>
+
+static FHash* g_ids; // FHash<const char*, FStrId*>
+
+static void f_strid__init(void)
+{
+    g_ids = f_hash_newStr(256, false);
+}
+
+static void f_strid__uninit(void)
+{
+    f_hash_freeEx(g_ids, f_mem_free);
+}
+
+const FPack f_pack__strid = {
+    "StrId",
+    f_strid__init,
+    f_strid__uninit,
+};
+
+const FStrId* f_strid_new(const char* String)
+{
+    FStrId* id = f_hash_get(g_ids, String);
+
+    if(id == NULL) {
+        size_t size = strlen(String) + 1;
+
+        // The string is stored right after its FStrId header
+        id = f_mem_malloc(sizeof(FStrId) + size);
+
+        id->string = memcpy(id + 1, String, size);
+        id->hash = f_hash__strHash(String);
+
+        f_hash_add(g_ids, id->string, id);
+    }
+
+    return id;
+}
+
+const char* f_strid_stringGet(const FStrId* Id)
+{
+    return Id->string;
+}
@@ -0,0 +1,32 @@
+/*
+    Copyright 2020 Alex Margarit <alex@alxm.org>
+    This file is part of Faur, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3,
+    as published by the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef F_INC_STRINGS_STRID_V_H
+#define F_INC_STRINGS_STRID_V_H
+
+#include "f_strid.p.h"
+
+#include "../general/f_init.v.h"
+
+struct FStrId {
+    const char* string; // interned copy, same pointer for equal strings
+    unsigned hash; // string's f_hash_newStr hash, before mixing
+};
+
+extern const FPack f_pack__strid;
+
+#endif // F_INC_STRINGS_STRID_V_H
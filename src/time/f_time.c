@@ -23,6 +23,11 @@ uint32_t f_time_msGet(void)
     return f_platform_api__timeMsGet();
 }
 
+uint32_t f_time_usGet(void)
+{
+    return f_platform_api__timeUsGet();
+}
+
 void f_time_msWait(uint32_t Ms)
 {
     f_platform_api__timeMsWait(Ms);
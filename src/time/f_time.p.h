@@ -23,6 +23,7 @@
 #include "../general/f_fps.p.h"
 
 extern uint32_t f_time_msGet(void);
+extern uint32_t f_time_usGet(void);
 extern void f_time_msWait(uint32_t Ms);
 extern void f_time_msSpin(uint32_t Ms);
 